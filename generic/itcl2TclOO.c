@@ -165,18 +165,6 @@ Itcl_InvokeProcedureMethod(
 	    (ProcedureMethod *)mPtr->clientData, objc, objv);
 }
 
-static int
-FreeProcedureMethod(
-    void *data[],
-    TCL_UNUSED(Tcl_Interp *),
-    int result)
-{
-    ProcedureMethod *pmPtr = (ProcedureMethod *)data[0];
-
-    Tcl_Free(pmPtr);
-    return result;
-}
-
 static void
 EnsembleErrorProc(
     Tcl_Interp *interp,
@@ -193,14 +181,22 @@ EnsembleErrorProc(
 	    (overflow ? "..." : ""), Tcl_GetErrorLine(interp)));
 }
 
-int
-Itcl_InvokeEnsembleMethod(
-    Tcl_Interp *interp,
-    Tcl_Namespace *nsPtr,       /* namespace to call the method in */
-    Tcl_Obj *namePtr,           /* name of the method */
-    Tcl_Proc *procPtr,
-    Tcl_Size objc,			/* Number of arguments. */
-    Tcl_Obj *const *objv)	/* Arguments as actually seen. */
+/*
+ * ----------------------------------------------------------------------
+ *
+ * Itcl_NewEnsembleMethod, Itcl_InvokeEnsembleMethod --
+ *
+ *	An ensemble part keeps the method record for its proc from creation
+ *	on, so invoking the part does not build one for every call.  The
+ *	record is only read while a call is set up, so recursive calls can
+ *	share it.
+ *
+ * ----------------------------------------------------------------------
+ */
+
+void *
+Itcl_NewEnsembleMethod(
+    Tcl_Proc procPtr)
 {
     ProcedureMethod *pmPtr = (ProcedureMethod *)Tcl_Alloc(sizeof(ProcedureMethod));
 
@@ -209,10 +205,20 @@ Itcl_InvokeEnsembleMethod(
     pmPtr->procPtr = (Proc *)procPtr;
     pmPtr->flags = USE_DECLARER_NS;
     pmPtr->errProc = EnsembleErrorProc;
+    return pmPtr;
+}
 
-    Tcl_NRAddCallback(interp, FreeProcedureMethod, pmPtr, NULL, NULL, NULL);
+int
+Itcl_InvokeEnsembleMethod(
+    Tcl_Interp *interp,
+    Tcl_Namespace *nsPtr,       /* namespace to call the method in */
+    Tcl_Obj *namePtr,           /* name of the method */
+    void *methodPtr,            /* from Itcl_NewEnsembleMethod */
+    Tcl_Size objc,			/* Number of arguments. */
+    Tcl_Obj *const *objv)	/* Arguments as actually seen. */
+{
     return Tcl_InvokeClassProcedureMethod(interp, namePtr, nsPtr,
-	    pmPtr, objc, objv);
+	    (ProcedureMethod *)methodPtr, objc, objv);
 }
 
 
@@ -342,6 +348,134 @@ Itcl_NewForwardClassMethod(
 }
 
 
+/*
+ * ----------------------------------------------------------------------
+ *
+ * Itcl_NewDelegateClassMethod --
+ *
+ *	Create a method for a class that is invoked like a forwarded
+ *	method, except that the prefix is asked for at each call from
+ *	prefixProc, so that each object of the class can forward to its
+ *	own target.  The prefix list must be kept alive by its owner.
+ *
+ * ----------------------------------------------------------------------
+ */
+
+typedef struct DelegateMethod {
+    ItclDelegatePrefixProc *prefixProc;
+    void *clientData;
+} DelegateMethod;
+
+static int
+ClearRootEnsemble(
+    TCL_UNUSED(void **),
+    Tcl_Interp *interp,
+    int result)
+{
+    TclResetRewriteEnsemble(interp, 1);
+    return result;
+}
+
+static int
+FinalizeDelegateCall(
+    void *data[],
+    Tcl_Interp *interp,
+    int result)
+{
+    Tcl_Obj **argObjs = (Tcl_Obj **)data[0];
+    Tcl_Obj *prefixObj = (Tcl_Obj *)data[1];
+
+    TclStackFree(interp, argObjs);
+    Tcl_DecrRefCount(prefixObj);
+    return result;
+}
+
+static int
+InvokeDelegateMethod(
+    void *clientData,
+    Tcl_Interp *interp,
+    Tcl_ObjectContext context,
+    int objc,
+    Tcl_Obj *const *objv)
+{
+    CallContext *contextPtr = (CallContext *)context;
+    DelegateMethod *dmPtr = (DelegateMethod *)clientData;
+    Tcl_Obj *prefixObj;
+    Tcl_Obj **prefixObjs;
+    Tcl_Obj **argObjs;
+    Tcl_Size numPrefixes;
+    Tcl_Size len;
+    int skip = contextPtr->skip;
+
+    prefixObj = dmPtr->prefixProc(dmPtr->clientData, interp,
+	    (Tcl_Object)contextPtr->oPtr);
+    if (prefixObj == NULL) {
+	return TCL_ERROR;
+    }
+    Tcl_IncrRefCount(prefixObj);
+    Tcl_ListObjGetElements(NULL, prefixObj, &numPrefixes, &prefixObjs);
+    len = numPrefixes + objc - skip;
+    argObjs = (Tcl_Obj **)TclStackAlloc(interp, sizeof(Tcl_Obj *) * len);
+    memcpy(argObjs, prefixObjs, sizeof(Tcl_Obj *) * numPrefixes);
+    memcpy(argObjs + numPrefixes, objv + skip,
+	    sizeof(Tcl_Obj *) * (objc - skip));
+    if (TclInitRewriteEnsemble(interp, skip, numPrefixes, objv)) {
+	Tcl_NRAddCallback(interp, ClearRootEnsemble, NULL, NULL, NULL, NULL);
+    }
+    Tcl_NRAddCallback(interp, FinalizeDelegateCall, argObjs, prefixObj,
+	    NULL, NULL);
+    ((Interp *)interp)->lookupNsPtr =
+	    (Namespace *)contextPtr->oPtr->namespacePtr;
+    return TclNREvalObjv(interp, len, argObjs, TCL_EVAL_NOERR, NULL);
+}
+
+static void
+DeleteDelegateMethod(
+    void *clientData)
+{
+    Tcl_Free(clientData);
+}
+
+static int
+CloneDelegateMethod(
+    TCL_UNUSED(Tcl_Interp *),
+    void *clientData,
+    void **newClientData)
+{
+    DelegateMethod *dmPtr = (DelegateMethod *)Tcl_Alloc(
+	    sizeof(DelegateMethod));
+
+    *dmPtr = *(DelegateMethod *)clientData;
+    *newClientData = dmPtr;
+    return TCL_OK;
+}
+
+static const Tcl_MethodType delegateMethodType = {
+    TCL_OO_METHOD_VERSION_CURRENT,
+    "itcl delegated method",
+    InvokeDelegateMethod,
+    DeleteDelegateMethod,
+    CloneDelegateMethod
+};
+
+Tcl_Method
+Itcl_NewDelegateClassMethod(
+    Tcl_Interp *interp,
+    Tcl_Class clsPtr,
+    int flags,
+    Tcl_Obj *nameObj,
+    ItclDelegatePrefixProc *prefixProc,
+    void *clientData)
+{
+    DelegateMethod *dmPtr;
+
+    dmPtr = (DelegateMethod *)Tcl_Alloc(sizeof(DelegateMethod));
+    dmPtr->prefixProc = prefixProc;
+    dmPtr->clientData = clientData;
+    return Tcl_NewMethod(interp, clsPtr, nameObj, flags,
+	    &delegateMethodType, dmPtr);
+}
+
 static Tcl_Obj *
 Itcl_TclOOObjectName(
     Tcl_Interp *interp,
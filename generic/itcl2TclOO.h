@@ -24,10 +24,16 @@ MODULE_SCOPE int Itcl_PublicObjectCmd(void *clientData, Tcl_Interp *interp,
 	Tcl_Class clsPtr, Tcl_Size objc, Tcl_Obj *const *objv);
 MODULE_SCOPE Tcl_Method Itcl_NewForwardClassMethod(Tcl_Interp *interp,
 	Tcl_Class clsPtr, int flags, Tcl_Obj *nameObj, Tcl_Obj *prefixObj);
+typedef Tcl_Obj *(ItclDelegatePrefixProc)(void *clientData,
+	Tcl_Interp *interp, Tcl_Object oPtr);
+MODULE_SCOPE Tcl_Method Itcl_NewDelegateClassMethod(Tcl_Interp *interp,
+	Tcl_Class clsPtr, int flags, Tcl_Obj *nameObj,
+	ItclDelegatePrefixProc *prefixProc, void *clientData);
 MODULE_SCOPE int Itcl_SelfCmd(void *clientData, Tcl_Interp *interp,
 	int objc, Tcl_Obj *const *objv);
 MODULE_SCOPE int Itcl_IsMethodCallFrame(Tcl_Interp *interp);
+MODULE_SCOPE void *Itcl_NewEnsembleMethod(Tcl_Proc procPtr);
 MODULE_SCOPE int Itcl_InvokeEnsembleMethod(Tcl_Interp *interp, Tcl_Namespace *nsPtr,
-    Tcl_Obj *namePtr, Tcl_Proc *procPtr, Tcl_Size objc, Tcl_Obj *const *objv);
+    Tcl_Obj *namePtr, void *methodPtr, Tcl_Size objc, Tcl_Obj *const *objv);
 MODULE_SCOPE int Itcl_InvokeProcedureMethod(void *clientData, Tcl_Interp *interp,
 	int objc, Tcl_Obj *const *objv);
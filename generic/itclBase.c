@@ -294,6 +294,7 @@ Initialize (
     Tcl_InitHashTable(&infoPtr->procMethods, TCL_ONE_WORD_KEYS);
     Tcl_InitHashTable(&infoPtr->instances, TCL_STRING_KEYS);
     Tcl_InitHashTable(&infoPtr->frameContext, TCL_ONE_WORD_KEYS);
+    Tcl_InitHashTable(&infoPtr->contextCallRecords, TCL_ONE_WORD_KEYS);
     Tcl_InitObjHashTable(&infoPtr->classTypes);
 
     infoPtr->ensembleInfo = (EnsembleInfo *)Tcl_Alloc(sizeof(EnsembleInfo));
@@ -321,6 +322,7 @@ Initialize (
 	    ITCL_NAMESPACE"::internal::dicts::classFunctions", NULL, "", 0);
     Tcl_SetVar2(interp,
 	    ITCL_NAMESPACE"::internal::dicts::classDelegatedFunctions", NULL, "", 0);
+    ItclTraceDictsVars(interp);
 
     hPtr = Tcl_CreateHashEntry(&infoPtr->classTypes,
 	    (char *)Tcl_NewStringObj("class", TCL_INDEX_NONE), &isNew);
@@ -345,6 +347,11 @@ Initialize (
 	opt = atoi(res_option);
     }
     infoPtr->useOldResolvers = opt;
+    res_option = getenv("ITCL_FLAT_VARIABLES");
+    if (res_option != NULL) {
+	infoPtr->flatVariables = atoi(res_option);
+    }
+    infoPtr->emptyObjectExt = ItclNewObjectExt();
     Itcl_InitStack(&infoPtr->clsStack);
 
     Tcl_SetAssocData(interp, ITCL_INTERP_DATA, NULL, infoPtr);
@@ -635,6 +642,7 @@ FreeItclObjectInfo(
     Tcl_DeleteHashTable(&infoPtr->classes);
     Tcl_DeleteHashTable(&infoPtr->nameClasses);
     Tcl_DeleteHashTable(&infoPtr->namespaceClasses);
+    ItclFreeObjectExt(infoPtr->emptyObjectExt);
 
     assert (infoPtr->infoVarsPtr == NULL);
     assert (infoPtr->infoVars4Ptr == NULL);
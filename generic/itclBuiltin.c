@@ -98,11 +98,31 @@ static Tcl_ObjCmdProc Itcl_BiKeepComponentOptionCmd;
 static Tcl_ObjCmdProc Itcl_BiIgnoreComponentOptionCmd;
 static Tcl_ObjCmdProc Itcl_BiInitOptionsCmd;
 
+/*
+ *  New value of a public variable during "configure -option value ...".
+ */
+typedef struct ConfigChange {
+    ItclVarLookup *vlookup;    /* the variable */
+    Tcl_Obj *valuePtr;         /* value to be set */
+    Tcl_Obj *oldValuePtr;      /* value to restore if the configuration
+				* fails, or NULL if not set yet */
+} ConfigChange;
+
+#define CONFIG_STATIC_CHANGES 8
+
 /*
  *  FORWARD DECLARATIONS
  */
 static Tcl_Obj* ItclReportPublicOpt(Tcl_Interp *interp,
     ItclVariable *ivPtr, ItclObject *contextIoPtr);
+static Tcl_Obj* ItclReportPublicOpts(Tcl_Interp *interp,
+    ItclObject *contextIoPtr);
+static Tcl_Obj* GetPublicVar(Tcl_Interp *interp, ItclObject *contextIoPtr,
+    ItclVarLookup *vlookup);
+static int SetPublicVar(Tcl_Interp *interp, ItclObject *contextIoPtr,
+    ItclVarLookup *vlookup, Tcl_Obj *valuePtr, int flags);
+static void RestorePublicVars(Tcl_Interp *interp, ItclObject *contextIoPtr,
+    ConfigChange *changes, Tcl_Size numChanges);
 
 static Tcl_ObjCmdProc ItclBiClassUnknownCmd;
 /*
@@ -575,22 +595,19 @@ Itcl_BiConfigureCmd(
 
     Tcl_Obj *resultPtr;
     Tcl_Obj *objPtr;
-    Tcl_DString buffer;
-    Tcl_DString buffer2;
-    Tcl_HashSearch place;
     Tcl_HashEntry *hPtr;
     Tcl_Namespace *saveNsPtr;
     Tcl_Obj *const *unparsedObjv;
-    ItclClass *iclsPtr;
     ItclVariable *ivPtr;
     ItclVarLookup *vlookup;
     ItclMemberCode *mcode;
-    ItclHierIter hier;
     ItclObjectInfo *infoPtr;
-    const char *lastval;
+    ConfigChange staticChanges[CONFIG_STATIC_CHANGES];
+    ConfigChange *changes;
     const char *token;
-    char *varName;
     Tcl_Size i;
+    Tcl_Size j;
+    Tcl_Size numChanges;
     Tcl_Size unparsedObjc;
     int result;
 
@@ -600,8 +617,6 @@ Itcl_BiConfigureCmd(
     hPtr = NULL;
     unparsedObjc = objc;
     unparsedObjv = objv;
-    Tcl_DStringInit(&buffer);
-    Tcl_DStringInit(&buffer2);
 
     /*
      *  Make sure that this command is being invoked in the proper
@@ -649,25 +664,7 @@ Itcl_BiConfigureCmd(
      *  HANDLE:  configure
      */
     if (unparsedObjc == 1) {
-	resultPtr = Tcl_NewListObj(0, NULL);
-
-	Itcl_InitHierIter(&hier, contextIclsPtr);
-	while ((iclsPtr=Itcl_AdvanceHierIter(&hier)) != NULL) {
-	    hPtr = Tcl_FirstHashEntry(&iclsPtr->variables, &place);
-	    while (hPtr) {
-		ivPtr = (ItclVariable*)Tcl_GetHashValue(hPtr);
-		if (ivPtr->protection == ITCL_PUBLIC) {
-		    objPtr = ItclReportPublicOpt(interp, ivPtr, contextIoPtr);
-
-		    Tcl_ListObjAppendElement(NULL, resultPtr,
-			objPtr);
-		}
-		hPtr = Tcl_NextHashEntry(&place);
-	    }
-	}
-	Itcl_DeleteHierIter(&hier);
-
-	Tcl_SetObjResult(interp, resultPtr);
+	Tcl_SetObjResult(interp, ItclReportPublicOpts(interp, contextIoPtr));
 	return TCL_OK;
     } else {
 
@@ -714,8 +711,19 @@ Itcl_BiConfigureCmd(
      *  (from Itcl_ExecMethod()) will be that base class.  Activate
      *  the derived class namespace here, so that instance variables
      *  are accessed properly.
+     *
+     *  All options are looked up and all new values are stored before
+     *  any "config" code runs, so the code sees the whole new
+     *  configuration and runs once per variable, even if an option
+     *  is given more than once.
      */
     result = TCL_OK;
+    numChanges = 0;
+    changes = staticChanges;
+    if (unparsedObjc / 2 > CONFIG_STATIC_CHANGES) {
+	changes = (ConfigChange *)Tcl_Alloc(
+		sizeof(ConfigChange) * (unparsedObjc / 2));
+    }
 
     for (i=1; i < unparsedObjc; i+=2) {
 	if (i+1 >= unparsedObjc) {
@@ -748,32 +756,35 @@ Itcl_BiConfigureCmd(
 	    goto configureDone;
 	}
 
-	ivPtr = vlookup->ivPtr;
-	Tcl_DStringSetLength(&buffer2, 0);
-	if (!(ivPtr->flags & ITCL_COMMON)) {
-	    Tcl_DStringAppend(&buffer2,
-		    Tcl_GetString(contextIoPtr->varNsNamePtr), TCL_INDEX_NONE);
+	for (j = 0; j < numChanges; j++) {
+	    if (changes[j].vlookup->ivPtr == vlookup->ivPtr) {
+		break;
+	    }
 	}
-	Tcl_DStringAppend(&buffer2,
-		Tcl_GetString(ivPtr->iclsPtr->fullNamePtr), TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer2, "::", 2);
-	Tcl_DStringAppend(&buffer2,
-		Tcl_GetString(ivPtr->namePtr), TCL_INDEX_NONE);
-	varName = Tcl_DStringValue(&buffer2);
-	lastval = Tcl_GetVar2(interp, varName, NULL, 0);
-	Tcl_DStringSetLength(&buffer, 0);
-	Tcl_DStringAppend(&buffer, (lastval) ? lastval : "", TCL_INDEX_NONE);
+	if (j == numChanges) {
+	    changes[j].vlookup = vlookup;
+	    changes[j].oldValuePtr = NULL;
+	    numChanges++;
+	}
+	changes[j].valuePtr = unparsedObjv[i+1];
+    }
 
-	token = Tcl_GetString(unparsedObjv[i+1]);
-	if (Tcl_SetVar2(interp, varName, NULL, token,
-		TCL_LEAVE_ERR_MSG) == NULL) {
+    for (j = 0; j < numChanges; j++) {
+	objPtr = GetPublicVar(interp, contextIoPtr, changes[j].vlookup);
+	changes[j].oldValuePtr = (objPtr != NULL) ? objPtr : Tcl_NewObj();
+	Tcl_IncrRefCount(changes[j].oldValuePtr);
+	if (SetPublicVar(interp, contextIoPtr, changes[j].vlookup,
+		changes[j].valuePtr, TCL_LEAVE_ERR_MSG) != TCL_OK) {
 	    Tcl_AppendObjToErrorInfo(interp, Tcl_ObjPrintf(
 		    "\n    (error in configuration of public variable \"%s\")",
-		    Tcl_GetString(ivPtr->fullNamePtr)));
+		    Tcl_GetString(changes[j].vlookup->ivPtr->fullNamePtr)));
 	    result = TCL_ERROR;
+	    RestorePublicVars(interp, contextIoPtr, changes, j);
 	    goto configureDone;
 	}
+    }
 
+    for (j = 0; j < numChanges; j++) {
 	/*
 	 *  If this variable has some "config" code, invoke it now.
 	 *
@@ -782,6 +793,7 @@ Itcl_BiConfigureCmd(
 	 *    calling context, and not in the context that we've
 	 *    set up for public variable access.
 	 */
+	ivPtr = changes[j].vlookup->ivPtr;
 	mcode = ivPtr->codePtr;
 	if (mcode && Itcl_IsMemberCodeImplemented(mcode)) {
 	    if (!ivPtr->iclsPtr->infoPtr->useOldResolvers) {
@@ -794,12 +806,11 @@ Itcl_BiConfigureCmd(
 	    if (result == TCL_OK) {
 		Tcl_ResetResult(interp);
 	    } else {
-		    Tcl_AppendObjToErrorInfo(interp, Tcl_ObjPrintf(
-			    "\n    (error in configuration of public variable \"%s\")",
-			    Tcl_GetString(ivPtr->fullNamePtr)));
-		Tcl_SetVar2(interp, varName,NULL,
-		    Tcl_DStringValue(&buffer), 0);
-
+		Tcl_AppendObjToErrorInfo(interp, Tcl_ObjPrintf(
+			"\n    (error in configuration of public variable \"%s\")",
+			Tcl_GetString(ivPtr->fullNamePtr)));
+		RestorePublicVars(interp, contextIoPtr, changes + j,
+			numChanges - j);
 		goto configureDone;
 	    }
 	}
@@ -814,8 +825,14 @@ configureDone:
 	infoPtr->unparsedObjv = NULL;
 	infoPtr->unparsedObjc = 0;
     }
-    Tcl_DStringFree(&buffer2);
-    Tcl_DStringFree(&buffer);
+    for (j = 0; j < numChanges; j++) {
+	if (changes[j].oldValuePtr != NULL) {
+	    Tcl_DecrRefCount(changes[j].oldValuePtr);
+	}
+    }
+    if (changes != staticChanges) {
+	Tcl_Free(changes);
+    }
 
     return result;
 }
@@ -980,6 +997,200 @@ ItclReportPublicOpt(
     return listPtr;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclReportPublicOpts()
+ *
+ *  Returns the list of all public variables of an object formatted as
+ *  configuration options, for "configure" without arguments.  The list
+ *  is kept with the object and reused for as long as the variables hold
+ *  the same values; since it keeps a reference to each value, a write
+ *  always leaves a different value object in the variable.  Entries of
+ *  variables that changed are rebuilt, the others are shared.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj*
+ItclReportPublicOpts(
+    Tcl_Interp *interp,      /* interpreter containing the object */
+    ItclObject *contextIoPtr) /* object containing the variables */
+{
+    ItclClass *iclsPtr;
+    ItclPublicOpt *optPtr;
+    Tcl_Obj *cachePtr;
+    Tcl_Obj *resultPtr;
+    Tcl_Obj *valuePtr;
+    Tcl_Obj *cachedValuePtr;
+    Tcl_Obj *objv[3];
+    Tcl_Obj **elemv;
+    Tcl_Size elemc;
+    Tcl_Size i;
+    Tcl_Size j;
+
+    iclsPtr = contextIoPtr->iclsPtr;
+    ItclBuildPublicOpts(iclsPtr);
+
+    cachePtr = contextIoPtr->configReportPtr;
+    elemv = NULL;
+    if ((cachePtr != NULL) && ((Tcl_ListObjGetElements(NULL, cachePtr,
+	    &elemc, &elemv) != TCL_OK) || (elemc != iclsPtr->numPublicOpts))) {
+	cachePtr = NULL;
+    }
+    resultPtr = NULL;
+    for (i = 0; i < iclsPtr->numPublicOpts; i++) {
+	optPtr = &iclsPtr->publicOpts[i];
+	valuePtr = GetPublicVar(interp, contextIoPtr, optPtr->vlookup);
+	if ((cachePtr != NULL) && (valuePtr != NULL)
+		&& (Tcl_ListObjIndex(NULL, elemv[i], 2,
+		&cachedValuePtr) == TCL_OK)
+		&& (cachedValuePtr == valuePtr)) {
+	    if (resultPtr != NULL) {
+		Tcl_ListObjAppendElement(NULL, resultPtr, elemv[i]);
+	    }
+	    continue;
+	}
+	if (resultPtr == NULL) {
+	    resultPtr = Tcl_NewListObj(iclsPtr->numPublicOpts, NULL);
+	    for (j = 0; j < i; j++) {
+		Tcl_ListObjAppendElement(NULL, resultPtr, elemv[j]);
+	    }
+	}
+	objv[0] = optPtr->optionNamePtr;
+	objv[1] = optPtr->initPtr;
+	if (valuePtr != NULL) {
+	    objv[2] = valuePtr;
+	} else {
+	    objv[2] = Tcl_NewStringObj("<undefined>", TCL_INDEX_NONE);
+	}
+	Tcl_ListObjAppendElement(NULL, resultPtr, Tcl_NewListObj(3, objv));
+    }
+    if (resultPtr == NULL) {
+	if (cachePtr != NULL) {
+	    return cachePtr;
+	}
+	resultPtr = Tcl_NewObj();
+    }
+    Tcl_IncrRefCount(resultPtr);
+    if (contextIoPtr->configReportPtr != NULL) {
+	Tcl_DecrRefCount(contextIoPtr->configReportPtr);
+    }
+    contextIoPtr->configReportPtr = resultPtr;
+    return resultPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  PublicVarName()
+ *
+ *  Returns the fully qualified name of a public variable of an object.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj*
+PublicVarName(
+    ItclObject *contextIoPtr,
+    ItclVariable *ivPtr)
+{
+    if (!(ivPtr->flags & ITCL_COMMON)) {
+	return ItclInstanceVarName(contextIoPtr, ivPtr);
+    }
+    return Tcl_ObjPrintf("%s::%s", Tcl_GetString(ivPtr->iclsPtr->fullNamePtr),
+	    Tcl_GetString(ivPtr->namePtr));
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  GetPublicVar()
+ *
+ *  Returns the value of a public variable of an object, or NULL if it
+ *  is not set.  Untraced instance variables are read from the varSlots
+ *  of the object; anything else goes through the usual variable lookup.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj*
+GetPublicVar(
+    Tcl_Interp *interp,
+    ItclObject *contextIoPtr,
+    ItclVarLookup *vlookup)
+{
+    Tcl_Obj *namePtr;
+    Tcl_Obj *valuePtr;
+    Tcl_Var varPtr;
+
+    if (!(vlookup->ivPtr->flags & ITCL_COMMON)) {
+	varPtr = ItclGetObjectVarSlot(contextIoPtr, vlookup);
+	if (varPtr != NULL) {
+	    valuePtr = Itcl_GetPlainVar(varPtr);
+	    if (valuePtr != NULL) {
+		return valuePtr;
+	    }
+	}
+    }
+    namePtr = PublicVarName(contextIoPtr, vlookup->ivPtr);
+    Tcl_IncrRefCount(namePtr);
+    valuePtr = Tcl_ObjGetVar2(interp, namePtr, NULL, 0);
+    Tcl_DecrRefCount(namePtr);
+    return valuePtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  SetPublicVar()
+ *
+ *  Stores a new value in a public variable of an object, the same way
+ *  GetPublicVar() reads it.  Returns TCL_OK/TCL_ERROR; with
+ *  TCL_LEAVE_ERR_MSG in "flags" an error message is left in the
+ *  interpreter.
+ * ------------------------------------------------------------------------
+ */
+static int
+SetPublicVar(
+    Tcl_Interp *interp,
+    ItclObject *contextIoPtr,
+    ItclVarLookup *vlookup,
+    Tcl_Obj *valuePtr,
+    int flags)
+{
+    Tcl_Obj *namePtr;
+    Tcl_Obj *resultPtr;
+    Tcl_Var varPtr;
+
+    if (!(vlookup->ivPtr->flags & ITCL_COMMON)) {
+	varPtr = ItclGetObjectVarSlot(contextIoPtr, vlookup);
+	if ((varPtr != NULL) && Itcl_SetPlainVar(varPtr, valuePtr)) {
+	    return TCL_OK;
+	}
+    }
+    namePtr = PublicVarName(contextIoPtr, vlookup->ivPtr);
+    Tcl_IncrRefCount(namePtr);
+    resultPtr = Tcl_ObjSetVar2(interp, namePtr, NULL, valuePtr, flags);
+    Tcl_DecrRefCount(namePtr);
+    return (resultPtr != NULL) ? TCL_OK : TCL_ERROR;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  RestorePublicVars()
+ *
+ *  Puts back the values public variables had before a failed
+ *  "configure".  Errors are ignored, the interpreter result is kept.
+ * ------------------------------------------------------------------------
+ */
+static void
+RestorePublicVars(
+    Tcl_Interp *interp,
+    ItclObject *contextIoPtr,
+    ConfigChange *changes,
+    Tcl_Size numChanges)
+{
+    Tcl_Size i;
+
+    for (i = 0; i < numChanges; i++) {
+	if (changes[i].oldValuePtr != NULL) {
+	    SetPublicVar(interp, contextIoPtr, changes[i].vlookup,
+		    changes[i].oldValuePtr, 0);
+	}
+    }
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclReportOption()
@@ -1002,7 +1213,6 @@ ItclReportOption(
     Tcl_Obj *listPtr;
     Tcl_Obj *objPtr;
     ItclDelegatedOption *idoPtr;
-    const char *val;
 
     listPtr = Tcl_NewListObj(0, NULL);
     idoPtr = ioptPtr->iclsPtr->infoPtr->currIdoPtr;
@@ -1037,12 +1247,8 @@ ItclReportOption(
 	objPtr = Tcl_NewStringObj("<undefined>", TCL_INDEX_NONE);
     }
     Tcl_ListObjAppendElement(NULL, listPtr, objPtr);
-    val = ItclGetInstanceVar(interp, "itcl_options",
-	    Tcl_GetString(ioptPtr->namePtr),
-	    contextIoPtr, ioptPtr->iclsPtr);
-    if (val) {
-	objPtr = Tcl_NewStringObj((const char *)val, TCL_INDEX_NONE);
-    } else {
+    objPtr = ItclGetOptionValue(interp, contextIoPtr, ioptPtr, -1);
+    if (objPtr == NULL) {
 	objPtr = Tcl_NewStringObj("<undefined>", TCL_INDEX_NONE);
     }
     Tcl_ListObjAppendElement(NULL, listPtr, objPtr);
@@ -1323,7 +1529,6 @@ ItclBiClassUnknownCmd(
     Tcl_Obj *listPtr;
     Tcl_Obj *objPtr;
     Tcl_Obj *resPtr;
-    Tcl_DString buffer;
     ItclClass *iclsPtr;
     ItclObjectInfo *infoPtr;
     ItclComponent *icPtr;
@@ -1466,15 +1671,10 @@ ItclBiClassUnknownCmd(
 		    contextIclsPtr = NULL;
 		    contextIoPtr = NULL;
 		    Itcl_GetContext(interp, &contextIclsPtr, &contextIoPtr);
-		    Tcl_DStringInit(&buffer);
-		    Tcl_DStringAppend(&buffer,
-			    Tcl_GetString(contextIoPtr->varNsNamePtr), TCL_INDEX_NONE);
-		    Tcl_DStringAppend(&buffer,
-			    Tcl_GetString(idmPtr->icPtr->ivPtr->fullNamePtr),
-			    TCL_INDEX_NONE);
-		    val = Tcl_GetVar2(interp, Tcl_DStringValue(&buffer),
-			    NULL, 0);
-		    Tcl_DStringFree(&buffer);
+		    objPtr = ItclInstanceVarName(contextIoPtr,
+			    idmPtr->icPtr->ivPtr);
+		    val = Tcl_GetVar2(interp, Tcl_GetString(objPtr), NULL, 0);
+		    Tcl_DecrRefCount(objPtr);
 		}
 		if (val == NULL) {
 		    Tcl_AppendResult(interp, "INTERNAL ERROR: ",
@@ -1599,7 +1799,6 @@ ItclUnknownGuts(
     Tcl_Obj *listPtr = NULL;
     Tcl_Obj *objPtr;
     Tcl_Obj *resPtr;
-    Tcl_DString buffer;
     ItclClass *iclsPtr;
     ItclComponent *icPtr;
     ItclDelegatedFunction *idmPtr;
@@ -1639,7 +1838,7 @@ ItclUnknownGuts(
     }
     icPtr = NULL;
     if (!isItclHull) {
-	FOREACH_HASH_VALUE(icPtr, &ioPtr->objectComponents) {
+	FOREACH_HASH_VALUE(icPtr, &ITCL_OBJECT_EXT(ioPtr)->objectComponents) {
 	    if (icPtr->flags & ITCL_COMPONENT_INHERIT) {
 		val = Itcl_GetInstanceVar(interp,
 			Tcl_GetString(icPtr->namePtr), ioPtr,
@@ -1734,14 +1933,9 @@ ItclUnknownGuts(
 	    val = Tcl_GetVar2(interp, Tcl_GetString(objPtr), NULL, 0);
 	    Tcl_DecrRefCount(objPtr);
 	} else {
-	    Tcl_DStringInit(&buffer);
-	    Tcl_DStringAppend(&buffer,
-		    Tcl_GetString(ioPtr->varNsNamePtr), TCL_INDEX_NONE);
-	    Tcl_DStringAppend(&buffer,
-		    Tcl_GetString(idmPtr->icPtr->ivPtr->fullNamePtr), TCL_INDEX_NONE);
-	    val = Tcl_GetVar2(interp, Tcl_DStringValue(&buffer),
-		    NULL, 0);
-	    Tcl_DStringFree(&buffer);
+	    objPtr = ItclInstanceVarName(ioPtr, idmPtr->icPtr->ivPtr);
+	    val = Tcl_GetVar2(interp, Tcl_GetString(objPtr), NULL, 0);
+	    Tcl_DecrRefCount(objPtr);
 	}
 
 	if (val == NULL) {
@@ -1892,6 +2086,82 @@ static Tcl_Obj *makeAsOptionInfo(
     return objPtr;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  FindOptionDispatch()
+ *
+ *  Looks up what the option name "namePtr" stands for in an object.
+ *  Objects that have the options of their class share the dispatch
+ *  table of the class.  Objects that got options of their own look at
+ *  their objectOptions and objectDelegatedOptions tables instead and
+ *  get the result in "bufPtr".  Returns NULL for unknown names.
+ * ------------------------------------------------------------------------
+ */
+static ItclOptionDispatch *
+FindOptionDispatch(
+    ItclObject *ioPtr,
+    Tcl_Obj *namePtr,
+    ItclOptionDispatch *bufPtr)
+{
+    Tcl_HashEntry *hPtr;
+
+    if (ioPtr->flags & ITCL_OBJECT_CLASS_OPTIONS) {
+	ItclBuildOptionDispatch(ioPtr->iclsPtr);
+	hPtr = Tcl_FindHashEntry(&ioPtr->iclsPtr->optionDispatch,
+		(char *)namePtr);
+	if (hPtr == NULL) {
+	    return NULL;
+	}
+	return (ItclOptionDispatch *)Tcl_GetHashValue(hPtr);
+    }
+    bufPtr->ioptPtr = NULL;
+    bufPtr->idoPtr = NULL;
+    bufPtr->slotIndex = -1;
+    hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(ioPtr)->objectOptions,
+	    (char *)namePtr);
+    if (hPtr != NULL) {
+	bufPtr->ioptPtr = (ItclOption *)Tcl_GetHashValue(hPtr);
+    }
+    hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(ioPtr)->objectDelegatedOptions,
+	    (char *)namePtr);
+    if (hPtr != NULL) {
+	bufPtr->idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
+    }
+    if ((bufPtr->ioptPtr == NULL) && (bufPtr->idoPtr == NULL)) {
+	return NULL;
+    }
+    return bufPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  AllOptionsDelegation()
+ *
+ *  Returns the "delegate option *" entry of an object or NULL.
+ * ------------------------------------------------------------------------
+ */
+static ItclDelegatedOption *
+AllOptionsDelegation(
+    ItclObject *ioPtr)
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_Obj *objPtr;
+
+    if (ioPtr->flags & ITCL_OBJECT_CLASS_OPTIONS) {
+	ItclBuildOptionDispatch(ioPtr->iclsPtr);
+	return ioPtr->iclsPtr->allOptionsPtr;
+    }
+    objPtr = Tcl_NewStringObj("*", 1);
+    Tcl_IncrRefCount(objPtr);
+    hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(ioPtr)->objectDelegatedOptions,
+	    (char *)objPtr);
+    Tcl_DecrRefCount(objPtr);
+    if (hPtr == NULL) {
+	return NULL;
+    }
+    return (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclExtendedConfigure()
@@ -1932,11 +2202,12 @@ ItclExtendedConfigure(
     Tcl_Obj *listPtr2;
     Tcl_Obj *resultPtr;
     Tcl_Obj *objPtr;
+    Tcl_Obj *valuePtr;
     Tcl_Obj *optNamePtr;
-    Tcl_Obj *methodNamePtr;
     Tcl_Obj *configureMethodPtr;
     Tcl_Obj **lObjv;
     Tcl_Obj **newObjv;
+    Tcl_Obj *methodObjv[3];
     Tcl_Obj *lObjvOne[1];
     Tcl_Obj **lObjv2;
     Tcl_Obj **lObjv3;
@@ -1952,6 +2223,8 @@ ItclExtendedConfigure(
     ItclObject *ioPtr;
     ItclComponent *icPtr;
     ItclOption *ioptPtr;
+    ItclOptionDispatch *dispatchPtr;
+    ItclOptionDispatch dispatch;
     ItclObjectInfo *infoPtr;
     const char *val;
     Tcl_Size lObjc;
@@ -1996,53 +2269,42 @@ ItclExtendedConfigure(
 
     hPtr = NULL;
     /* first check if method configure is delegated */
-    methodNamePtr = Tcl_NewStringObj("*", TCL_INDEX_NONE);
-    hPtr = Tcl_FindHashEntry(&contextIclsPtr->delegatedFunctions, (char *)
-	    methodNamePtr);
-    if (hPtr != NULL) {
+    ItclBuildOptionDispatch(contextIclsPtr);
+    idmPtr = contextIclsPtr->configureIdmPtr;
+    if (idmPtr != NULL) {
 	/* all methods are delegated */
-	idmPtr = (ItclDelegatedFunction *)Tcl_GetHashValue(hPtr);
-	Tcl_SetStringObj(methodNamePtr, "configure", TCL_INDEX_NONE);
-	hPtr = Tcl_FindHashEntry(&idmPtr->exceptions, (char *)methodNamePtr);
-	if (hPtr == NULL) {
-	    icPtr = idmPtr->icPtr;
-	    val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
-		    NULL, contextIoPtr, contextIclsPtr);
-	    if (val != NULL) {
-		newObjv = (Tcl_Obj **)Tcl_Alloc(sizeof(Tcl_Obj *)*(objc+5));
-		newObjv[0] = Tcl_NewStringObj(val, TCL_INDEX_NONE);
-		Tcl_IncrRefCount(newObjv[0]);
-		newObjv[1] = Tcl_NewStringObj("configure", TCL_INDEX_NONE);
-		Tcl_IncrRefCount(newObjv[1]);
-		for(i=1;i<objc;i++) {
-		    newObjv[i+1] = objv[i];
-		}
-		objPtr = Tcl_NewStringObj(val, TCL_INDEX_NONE);
-		Tcl_IncrRefCount(objPtr);
-		oPtr = Tcl_GetObjectFromObj(interp, objPtr);
-		if (oPtr != NULL) {
-		    ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
-			    infoPtr->object_meta_type);
-		    infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
-		}
-		ItclShowArgs(1, "EXTENDED CONFIGURE EVAL1", objc+1, newObjv);
-		result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
-		Tcl_DecrRefCount(newObjv[0]);
-		Tcl_DecrRefCount(newObjv[1]);
-		Tcl_Free(newObjv);
-		Tcl_DecrRefCount(objPtr);
-		if (oPtr != NULL) {
-		    infoPtr->currContextIclsPtr = NULL;
-		}
-		Tcl_DecrRefCount(methodNamePtr);
-		return result;
+	icPtr = idmPtr->icPtr;
+	val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
+		NULL, contextIoPtr, contextIclsPtr);
+	if (val != NULL) {
+	    newObjv = (Tcl_Obj **)Tcl_Alloc(sizeof(Tcl_Obj *)*(objc+5));
+	    newObjv[0] = Tcl_NewStringObj(val, TCL_INDEX_NONE);
+	    Tcl_IncrRefCount(newObjv[0]);
+	    newObjv[1] = Tcl_NewStringObj("configure", TCL_INDEX_NONE);
+	    Tcl_IncrRefCount(newObjv[1]);
+	    for(i=1;i<objc;i++) {
+		newObjv[i+1] = objv[i];
 	    }
-	} else {
-	    /* configure is not delegated, so reset hPtr for checks later on! */
-	    hPtr = NULL;
+	    objPtr = Tcl_NewStringObj(val, TCL_INDEX_NONE);
+	    Tcl_IncrRefCount(objPtr);
+	    oPtr = Tcl_GetObjectFromObj(interp, objPtr);
+	    if (oPtr != NULL) {
+		ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
+			infoPtr->object_meta_type);
+		infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
+	    }
+	    ItclShowArgs(1, "EXTENDED CONFIGURE EVAL1", objc+1, newObjv);
+	    result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
+	    Tcl_DecrRefCount(newObjv[0]);
+	    Tcl_DecrRefCount(newObjv[1]);
+	    Tcl_Free(newObjv);
+	    Tcl_DecrRefCount(objPtr);
+	    if (oPtr != NULL) {
+		infoPtr->currContextIclsPtr = NULL;
+	    }
+	    return result;
 	}
     }
-    Tcl_DecrRefCount(methodNamePtr);
     /* now do the hard work */
     if (objc == 1) {
 	Tcl_InitObjHashTable(&unique);
@@ -2052,7 +2314,7 @@ ItclExtendedConfigure(
 	    result = Tcl_EvalEx(interp, "::itcl::builtin::getEclassOptions", TCL_INDEX_NONE, 0);
 	    return result;
 	}
-	FOREACH_HASH_VALUE(ioptPtr, &contextIoPtr->objectOptions) {
+	FOREACH_HASH_VALUE(ioptPtr, &ITCL_OBJECT_EXT(contextIoPtr)->objectOptions) {
 	    hPtr2 = Tcl_CreateHashEntry(&unique,
 		    (char *)ioptPtr->namePtr, &isNew);
 	    if (!isNew) {
@@ -2073,18 +2335,15 @@ ItclExtendedConfigure(
 		Tcl_ListObjAppendElement(interp, objPtr,
 			Tcl_NewStringObj("", TCL_INDEX_NONE));
 	    }
-	    val = ItclGetInstanceVar(interp, "itcl_options",
-		    Tcl_GetString(ioptPtr->namePtr), contextIoPtr,
-		    contextIclsPtr);
-	    if (val == NULL) {
-		val = "<undefined>";
+	    valuePtr = ItclGetOptionValue(interp, contextIoPtr, ioptPtr, -1);
+	    if (valuePtr == NULL) {
+		valuePtr = Tcl_NewStringObj("<undefined>", TCL_INDEX_NONE);
 	    }
-	    Tcl_ListObjAppendElement(interp, objPtr,
-		    Tcl_NewStringObj(val, TCL_INDEX_NONE));
+	    Tcl_ListObjAppendElement(interp, objPtr, valuePtr);
 	    Tcl_ListObjAppendElement(interp, listPtr, objPtr);
 	}
 	/* now check for delegated options */
-	FOREACH_HASH_VALUE(idoPtr, &contextIoPtr->objectDelegatedOptions) {
+	FOREACH_HASH_VALUE(idoPtr, &ITCL_OBJECT_EXT(contextIoPtr)->objectDelegatedOptions) {
 
 	    if (idoPtr->icPtr != NULL) {
 		icPtr = idoPtr->icPtr;
@@ -2200,34 +2459,29 @@ ItclExtendedConfigure(
 	Tcl_DeleteHashTable(&unique);
 	return TCL_OK;
     }
-    hPtr2 = NULL;
     /* first handle delegated options */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions, (char *)
-	    objv[1]);
-    if (hPtr == NULL) {
-	objPtr = Tcl_NewStringObj("*",1);
-	Tcl_IncrRefCount(objPtr);
+    dispatchPtr = FindOptionDispatch(contextIoPtr, objv[1], &dispatch);
+    idoPtr = NULL;
+    if (dispatchPtr != NULL) {
+	idoPtr = dispatchPtr->idoPtr;
+    }
+    if (idoPtr == NULL) {
 	/* check if all options are delegated */
-	hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions,
-		(char *)objPtr);
-	Tcl_DecrRefCount(objPtr);
-	if (hPtr != NULL) {
-	    /* now check the exceptions */
-	    idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_FindHashEntry(&idoPtr->exceptions, (char *)objv[1]);
-	    if (hPtr2 != NULL) {
-		/* found in exceptions, so no delegation for this option */
-		hPtr = NULL;
-	    }
+	idoPtr = AllOptionsDelegation(contextIoPtr);
+	if ((idoPtr != NULL) && (Tcl_FindHashEntry(&idoPtr->exceptions,
+		(char *)objv[1]) != NULL)) {
+	    /* found in exceptions, so no delegation for this option */
+	    idoPtr = NULL;
 	}
     }
     componentIcPtr = NULL;
     /* check if it is not a local option defined before delegate option "*"
      */
-    hPtr2 = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
-	    (char *)objv[1]);
-    if (hPtr != NULL) {
-	idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
+    ioptPtr = NULL;
+    if (dispatchPtr != NULL) {
+	ioptPtr = dispatchPtr->ioptPtr;
+    }
+    if (idoPtr != NULL) {
 	icPtr = idoPtr->icPtr;
 	if (icPtr != NULL) {
 	    if (icPtr->haveKeptOptions) {
@@ -2250,16 +2504,15 @@ ItclExtendedConfigure(
 		    }
 		    Itcl_DeleteHierIter(&hier);
 		    if (! found) {
-			hPtr2 = NULL;
+			ioptPtr = NULL;
 			componentIcPtr = icPtr;
 		    }
 		}
 	    }
 	}
     }
-    if ((objc <= 3) && (hPtr != NULL) && (hPtr2 == NULL)) {
+    if ((objc <= 3) && (idoPtr != NULL) && (ioptPtr == NULL)) {
 	/* the option is delegated */
-	idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
 	if (componentIcPtr != NULL) {
 	    icPtr = componentIcPtr;
 	} else {
@@ -2319,17 +2572,17 @@ ItclExtendedConfigure(
     if (objc == 2) {
 	saveIdoPtr = infoPtr->currIdoPtr;
 	/* now look if it is an option at all */
-	if (hPtr2 == NULL) {
+	if (ioptPtr == NULL) {
 	    hPtr2 = Tcl_FindHashEntry(&contextIclsPtr->options,
 		    (char *) objv[1]);
-	    if (hPtr2 == NULL) {
-		hPtr2 = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
-			(char *) objv[1]);
-	    } else {
-	       infoPtr->currIdoPtr = NULL;
+	    if (hPtr2 != NULL) {
+		ioptPtr = (ItclOption *)Tcl_GetHashValue(hPtr2);
+		infoPtr->currIdoPtr = NULL;
+	    } else if (dispatchPtr != NULL) {
+		ioptPtr = dispatchPtr->ioptPtr;
 	    }
 	}
-	if (hPtr2 == NULL) {
+	if (ioptPtr == NULL) {
 	    if (contextIclsPtr->flags & ITCL_ECLASS) {
 		newObjv = (Tcl_Obj **)Tcl_Alloc(sizeof(Tcl_Obj *) * (objc));
 		newObjv[0] = Tcl_NewStringObj("::itcl::builtin::eclassConfigure", TCL_INDEX_NONE);
@@ -2351,7 +2604,6 @@ ItclExtendedConfigure(
 	    infoPtr->currIdoPtr = saveIdoPtr;
 	    return TCL_CONTINUE;
 	}
-	ioptPtr = (ItclOption *)Tcl_GetHashValue(hPtr2);
 	resultPtr = ItclReportOption(interp, ioptPtr, contextIoPtr);
 	infoPtr->currIdoPtr = saveIdoPtr;
 	Tcl_SetObjResult(interp, resultPtr);
@@ -2365,9 +2617,12 @@ ItclExtendedConfigure(
 	    result = TCL_ERROR;
 	    break;
 	}
-	hPtr = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
-		(char *) objv[i]);
-	if (hPtr == NULL) {
+	dispatchPtr = FindOptionDispatch(contextIoPtr, objv[i], &dispatch);
+	ioptPtr = NULL;
+	if (dispatchPtr != NULL) {
+	    ioptPtr = dispatchPtr->ioptPtr;
+	}
+	if (ioptPtr == NULL) {
 	    if (contextIclsPtr->flags & ITCL_ECLASS) {
 		newObjv = (Tcl_Obj **)Tcl_Alloc(sizeof(Tcl_Obj *) * (objc));
 		newObjv[0] = Tcl_NewStringObj("::itcl::builtin::eclassConfigure", TCL_INDEX_NONE);
@@ -2385,11 +2640,9 @@ ItclExtendedConfigure(
 		  continue;
 		}
 	    }
-	    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions,
-		    (char *) objv[i]);
-	    if (hPtr != NULL) {
+	    if ((dispatchPtr != NULL) && (dispatchPtr->idoPtr != NULL)) {
 		/* the option is delegated */
-		idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
+		idoPtr = dispatchPtr->idoPtr;
 		icPtr = idoPtr->icPtr;
 		val = ItclGetInstanceVar(interp,
 			Tcl_GetString(icPtr->ivPtr->namePtr),
@@ -2439,7 +2692,7 @@ ItclExtendedConfigure(
 		}
 	    }
 	}
-	if (hPtr == NULL) {
+	if (ioptPtr == NULL) {
 	    infoPtr->unparsedObjc += 2;
 	    if (infoPtr->unparsedObjv == NULL) {
 		infoPtr->unparsedObjc++; /* keep the first slot for
@@ -2460,7 +2713,6 @@ ItclExtendedConfigure(
 	    /* FIXME !!! temporary */
 	    continue;
 	}
-	ioptPtr = (ItclOption *)Tcl_GetHashValue(hPtr);
 	if (ioptPtr->flags & ITCL_OPTION_READONLY) {
 	    if (infoPtr->currIoPtr == NULL) {
 		/* allow only setting during instance creation
@@ -2473,18 +2725,16 @@ ItclExtendedConfigure(
 	    }
 	}
 	if (ioptPtr->validateMethodPtr != NULL) {
-	    newObjv = (Tcl_Obj **)Tcl_Alloc(sizeof(Tcl_Obj *) * 3);
-	    newObjv[0] = ioptPtr->validateMethodPtr;
-	    newObjv[1] = objv[i];
-	    newObjv[2] = objv[i+1];
+	    methodObjv[0] = ioptPtr->validateMethodPtr;
+	    methodObjv[1] = objv[i];
+	    methodObjv[2] = objv[i+1];
 	    infoPtr->inOptionHandling = 1;
 	    saveNsPtr = Tcl_GetCurrentNamespace(interp);
 	    Itcl_SetCallFrameNamespace(interp, contextIclsPtr->nsPtr);
-	    ItclShowArgs(1, "EVAL validatemethod", 3, newObjv);
-	    result = Tcl_EvalObjv(interp, 3, newObjv, TCL_EVAL_DIRECT);
+	    ItclShowArgs(1, "EVAL validatemethod", 3, methodObjv);
+	    result = Tcl_EvalObjv(interp, 3, methodObjv, TCL_EVAL_DIRECT);
 	    Itcl_SetCallFrameNamespace(interp, saveNsPtr);
 	    infoPtr->inOptionHandling = 0;
-	    Tcl_Free(newObjv);
 	    if (result != TCL_OK) {
 		break;
 	    }
@@ -2526,30 +2776,27 @@ ItclExtendedConfigure(
 	    Tcl_IncrRefCount(configureMethodPtr);
 	}
 	if (configureMethodPtr != NULL) {
-	    newObjv = (Tcl_Obj **)Tcl_Alloc(sizeof(Tcl_Obj *)*3);
-	    newObjv[0] = configureMethodPtr;
-	    Tcl_IncrRefCount(newObjv[0]);
-	    newObjv[1] = objv[i];
-	    Tcl_IncrRefCount(newObjv[1]);
-	    newObjv[2] = objv[i+1];
-	    Tcl_IncrRefCount(newObjv[2]);
+	    methodObjv[0] = configureMethodPtr;
+	    Tcl_IncrRefCount(methodObjv[0]);
+	    methodObjv[1] = objv[i];
+	    Tcl_IncrRefCount(methodObjv[1]);
+	    methodObjv[2] = objv[i+1];
+	    Tcl_IncrRefCount(methodObjv[2]);
 	    saveNsPtr = Tcl_GetCurrentNamespace(interp);
 	    Itcl_SetCallFrameNamespace(interp, evalNsPtr);
-	    ItclShowArgs(1, "EVAL configuremethod", 3, newObjv);
-	    result = Tcl_EvalObjv(interp, 3, newObjv, TCL_EVAL_DIRECT);
-	    Tcl_DecrRefCount(newObjv[0]);
-	    Tcl_DecrRefCount(newObjv[1]);
-	    Tcl_DecrRefCount(newObjv[2]);
-	    Tcl_Free(newObjv);
+	    ItclShowArgs(1, "EVAL configuremethod", 3, methodObjv);
+	    result = Tcl_EvalObjv(interp, 3, methodObjv, TCL_EVAL_DIRECT);
+	    Tcl_DecrRefCount(methodObjv[0]);
+	    Tcl_DecrRefCount(methodObjv[1]);
+	    Tcl_DecrRefCount(methodObjv[2]);
 	    Itcl_SetCallFrameNamespace(interp, saveNsPtr);
 	    Tcl_DecrRefCount(configureMethodPtr);
 	    if (result != TCL_OK) {
 		break;
 	    }
 	} else {
-	    if (ItclSetInstanceVar(interp, "itcl_options",
-		    Tcl_GetString(objv[i]), Tcl_GetString(objv[i+1]),
-		    contextIoPtr, ioptPtr->iclsPtr) == NULL) {
+	    if (ItclSetOptionValue(interp, contextIoPtr, ioptPtr,
+		    dispatchPtr->slotIndex, objv[i+1]) != TCL_OK) {
 		result = TCL_ERROR;
 		break;
 	    }
@@ -2589,14 +2836,10 @@ ItclExtendedCget(
     int objc,                /* number of arguments */
     Tcl_Obj *const objv[])   /* argument objects */
 {
-    Tcl_HashEntry *hPtr;
-    Tcl_HashEntry *hPtr2;
-    Tcl_HashEntry *hPtr3;
-    Tcl_Obj *objPtr2;
     Tcl_Obj *objPtr;
     Tcl_Object oPtr;
-    Tcl_Obj *methodNamePtr;
     Tcl_Obj **newObjv;
+    Tcl_Obj *methodObjv[2];
     ItclClass *contextIclsPtr;
     ItclObject *contextIoPtr;
     ItclDelegatedFunction *idmPtr;
@@ -2604,6 +2847,8 @@ ItclExtendedCget(
     ItclComponent *icPtr;
     ItclObjectInfo *infoPtr;
     ItclOption *ioptPtr;
+    ItclOptionDispatch *dispatchPtr;
+    ItclOptionDispatch dispatch;
     ItclObject *ioPtr;
     const char *val;
     int i;
@@ -2636,77 +2881,64 @@ ItclExtendedCget(
 	contextIclsPtr = infoPtr->currContextIclsPtr;
     }
 
-    hPtr = NULL;
     /* first check if method cget is delegated */
-    methodNamePtr = Tcl_NewStringObj("*", TCL_INDEX_NONE);
-    hPtr = Tcl_FindHashEntry(&contextIclsPtr->delegatedFunctions, (char *)
-	    methodNamePtr);
-    if (hPtr != NULL) {
-	idmPtr = (ItclDelegatedFunction *)Tcl_GetHashValue(hPtr);
-	Tcl_SetStringObj(methodNamePtr, "cget", TCL_INDEX_NONE);
-	hPtr = Tcl_FindHashEntry(&idmPtr->exceptions, (char *)methodNamePtr);
-	if (hPtr == NULL) {
-	    icPtr = idmPtr->icPtr;
-	    val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
-		    NULL, contextIoPtr, contextIclsPtr);
-	    if (val != NULL) {
-		newObjv = (Tcl_Obj **)Tcl_Alloc(sizeof(Tcl_Obj *)*(objc+1));
-		newObjv[0] = Tcl_NewStringObj(val, TCL_INDEX_NONE);
-		Tcl_IncrRefCount(newObjv[0]);
-		newObjv[1] = Tcl_NewStringObj("cget", 4);
-		Tcl_IncrRefCount(newObjv[1]);
-		for(i=1;i<objc;i++) {
-		    newObjv[i+1] = objv[i];
-		}
-		objPtr = Tcl_NewStringObj(val, TCL_INDEX_NONE);
-		Tcl_IncrRefCount(objPtr);
-		oPtr = Tcl_GetObjectFromObj(interp, objPtr);
-		if (oPtr != NULL) {
-		    ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
-			    infoPtr->object_meta_type);
-		    infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
-		}
-		ItclShowArgs(1, "DELEGATED EVAL", objc+1, newObjv);
-		result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
-		Tcl_DecrRefCount(newObjv[0]);
-		Tcl_DecrRefCount(newObjv[1]);
-		Tcl_DecrRefCount(objPtr);
-		if (oPtr != NULL) {
-		    infoPtr->currContextIclsPtr = NULL;
-		}
-		Tcl_DecrRefCount(methodNamePtr);
-		return result;
+    ItclBuildOptionDispatch(contextIclsPtr);
+    idmPtr = contextIclsPtr->cgetIdmPtr;
+    if (idmPtr != NULL) {
+	/* all methods are delegated */
+	icPtr = idmPtr->icPtr;
+	val = ItclGetInstanceVar(interp, Tcl_GetString(icPtr->namePtr),
+		NULL, contextIoPtr, contextIclsPtr);
+	if (val != NULL) {
+	    newObjv = (Tcl_Obj **)Tcl_Alloc(sizeof(Tcl_Obj *)*(objc+1));
+	    newObjv[0] = Tcl_NewStringObj(val, TCL_INDEX_NONE);
+	    Tcl_IncrRefCount(newObjv[0]);
+	    newObjv[1] = Tcl_NewStringObj("cget", 4);
+	    Tcl_IncrRefCount(newObjv[1]);
+	    for(i=1;i<objc;i++) {
+		newObjv[i+1] = objv[i];
 	    }
+	    objPtr = Tcl_NewStringObj(val, TCL_INDEX_NONE);
+	    Tcl_IncrRefCount(objPtr);
+	    oPtr = Tcl_GetObjectFromObj(interp, objPtr);
+	    if (oPtr != NULL) {
+		ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
+			infoPtr->object_meta_type);
+		infoPtr->currContextIclsPtr = ioPtr->iclsPtr;
+	    }
+	    ItclShowArgs(1, "DELEGATED EVAL", objc+1, newObjv);
+	    result = Tcl_EvalObjv(interp, objc+1, newObjv, TCL_EVAL_DIRECT);
+	    Tcl_DecrRefCount(newObjv[0]);
+	    Tcl_DecrRefCount(newObjv[1]);
+	    Tcl_DecrRefCount(objPtr);
+	    Tcl_Free(newObjv);
+	    if (oPtr != NULL) {
+		infoPtr->currContextIclsPtr = NULL;
+	    }
+	    return result;
 	}
     }
-    Tcl_DecrRefCount(methodNamePtr);
     if (objc == 1) {
 	Tcl_WrongNumArgs(interp, 1, objv, "option");
 	return TCL_ERROR;
     }
     /* now do the hard work */
     /* first handle delegated options */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions, (char *)
-	    objv[1]);
-    hPtr3 = Tcl_FindHashEntry(&contextIoPtr->objectOptions, (char *)
-	    objv[1]);
-    hPtr2 = NULL;
-    if (hPtr == NULL) {
-	objPtr2 = Tcl_NewStringObj("*", TCL_INDEX_NONE);
+    dispatchPtr = FindOptionDispatch(contextIoPtr, objv[1], &dispatch);
+    ioptPtr = NULL;
+    idoPtr = NULL;
+    if (dispatchPtr != NULL) {
+	ioptPtr = dispatchPtr->ioptPtr;
+	idoPtr = dispatchPtr->idoPtr;
+    }
+    if (idoPtr == NULL) {
 	/* check for "*" option delegated */
-	hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions, (char *)
-		objPtr2);
-	Tcl_DecrRefCount(objPtr2);
-	hPtr2 = Tcl_FindHashEntry(&contextIoPtr->objectOptions, (char *)
-		objv[1]);
+	idoPtr = AllOptionsDelegation(contextIoPtr);
     }
-    if ((hPtr != NULL) && (hPtr2 == NULL) && (hPtr3 == NULL)) {
+    if ((idoPtr != NULL) && (ioptPtr == NULL)) {
 	/* the option is delegated */
-	idoPtr = (ItclDelegatedOption *)Tcl_GetHashValue(hPtr);
 	/* if the option is in the exceptions, do nothing */
-	hPtr = Tcl_FindHashEntry(&idoPtr->exceptions, (char *)
-		objv[1]);
-	if (hPtr) {
+	if (Tcl_FindHashEntry(&idoPtr->exceptions, (char *)objv[1])) {
 	    return TCL_CONTINUE;
 	}
 	icPtr = idoPtr->icPtr;
@@ -2765,36 +2997,27 @@ ItclExtendedCget(
     }
 
     /* now look if it is an option at all */
-    if ((hPtr2 == NULL) && (hPtr3 == NULL)) {
+    if (ioptPtr == NULL) {
 	/* no option at all, let the normal configure do the job */
 	return TCL_CONTINUE;
     }
-    if (hPtr3 != NULL) {
-	ioptPtr = (ItclOption *)Tcl_GetHashValue(hPtr3);
-    } else {
-	ioptPtr = (ItclOption *)Tcl_GetHashValue(hPtr2);
-    }
     result = TCL_CONTINUE;
     if (ioptPtr->cgetMethodPtr != NULL) {
-	newObjv = (Tcl_Obj **)Tcl_Alloc(sizeof(Tcl_Obj *)*2);
-	newObjv[0] = ioptPtr->cgetMethodPtr;
-	Tcl_IncrRefCount(newObjv[0]);
-	newObjv[1] = objv[1];
-	Tcl_IncrRefCount(newObjv[1]);
-	ItclShowArgs(1, "eval cget method", objc, newObjv);
-	result = Tcl_EvalObjv(interp, objc, newObjv, TCL_EVAL_DIRECT);
-	Tcl_DecrRefCount(newObjv[1]);
-	Tcl_DecrRefCount(newObjv[0]);
-	Tcl_Free(newObjv);
+	methodObjv[0] = ioptPtr->cgetMethodPtr;
+	Tcl_IncrRefCount(methodObjv[0]);
+	methodObjv[1] = objv[1];
+	Tcl_IncrRefCount(methodObjv[1]);
+	ItclShowArgs(1, "eval cget method", objc, methodObjv);
+	result = Tcl_EvalObjv(interp, objc, methodObjv, TCL_EVAL_DIRECT);
+	Tcl_DecrRefCount(methodObjv[1]);
+	Tcl_DecrRefCount(methodObjv[0]);
     } else {
-	val = ItclGetInstanceVar(interp, "itcl_options",
-		Tcl_GetString(ioptPtr->namePtr),
-		contextIoPtr, ioptPtr->iclsPtr);
-	if (val) {
-	    Tcl_SetObjResult(interp, Tcl_NewStringObj(val, TCL_INDEX_NONE));
-	} else {
-	    Tcl_SetObjResult(interp, Tcl_NewStringObj("<undefined>", TCL_INDEX_NONE));
+	objPtr = ItclGetOptionValue(interp, contextIoPtr, ioptPtr,
+		dispatchPtr->slotIndex);
+	if (objPtr == NULL) {
+	    objPtr = Tcl_NewStringObj("<undefined>", TCL_INDEX_NONE);
 	}
+	Tcl_SetObjResult(interp, objPtr);
 	result = TCL_OK;
     }
     return result;
@@ -2876,7 +3099,7 @@ ItclExtendedSetGet(
 	return TCL_ERROR;
     }
     /* look if it is an methodvariable at all */
-    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectMethodVariables,
+    hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(contextIoPtr)->objectMethodVariables,
 	    (char *) objv[1]);
     if (hPtr == NULL) {
 	Tcl_AppendResult(interp, "no such methodvariable \"",
@@ -2999,7 +3222,7 @@ Itcl_BiInstallComponentCmd(
     hPtr = Tcl_FindHashEntry(&contextIclsPtr->components, (char *)objv[1]);
     if (hPtr == NULL) {
 	numOpts = 0;
-	FOREACH_HASH_VALUE(idoPtr, &contextIoPtr->objectDelegatedOptions) {
+	FOREACH_HASH_VALUE(idoPtr, &ITCL_OBJECT_EXT(contextIoPtr)->objectDelegatedOptions) {
 	    if (idoPtr == NULL) {
 		/* FIXME need code here !! */
 	    }
@@ -3671,10 +3894,10 @@ Itcl_BiInitOptionsCmd(
 	return TCL_ERROR;
     }
     /* first handle delegated options */
-    FOREACH_HASH_VALUE(idoptPtr, &ioPtr->objectDelegatedOptions) {
+    FOREACH_HASH_VALUE(idoptPtr, &ITCL_OBJECT_EXT(ioPtr)->objectDelegatedOptions) {
 fprintf(stderr, "delopt!%s!\n", Tcl_GetString(idoptPtr->namePtr));
     }
-    FOREACH_HASH_VALUE(ioptPtr, &ioPtr->objectOptions) {
+    FOREACH_HASH_VALUE(ioptPtr, &ITCL_OBJECT_EXT(ioPtr)->objectOptions) {
 fprintf(stderr, "opt!%s!\n", Tcl_GetString(ioptPtr->namePtr));
     }
     return result;
@@ -3766,7 +3989,7 @@ Itcl_BiIgnoreComponentOptionCmd(
 	return TCL_ERROR;
     }
     if (ioPtr != NULL) {
-	hPtr = Tcl_FindHashEntry(&ioPtr->objectComponents, (char *)objv[1]);
+	hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(ioPtr)->objectComponents, (char *)objv[1]);
 	if (hPtr == NULL) {
 	    Tcl_AppendResult(interp,
 		    "ignorecomponentoption cannot find component \"",
@@ -3775,13 +3998,15 @@ Itcl_BiIgnoreComponentOptionCmd(
 	}
 	icPtr = (ItclComponent *)Tcl_GetHashValue(hPtr);
 	icPtr->haveKeptOptions = 1;
+	ioPtr->flags |= ITCL_OBJECT_OWN_OPTIONS;
+	ioPtr->flags &= ~ITCL_OBJECT_CLASS_OPTIONS;
 	for (idx = 2; idx < objc; idx++) {
 	    hPtr = Tcl_CreateHashEntry(&icPtr->keptOptions, (char *)objv[idx],
 		    &isNew);
 	    if (isNew) {
 		Tcl_SetHashValue(hPtr, objv[idx]);
 	    }
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectDelegatedOptions,
+	    hPtr2 = Tcl_CreateHashEntry(&ItclGetObjectExt(ioPtr)->objectDelegatedOptions,
 		    (char *)objv[idx], &isNew);
 	    if (isNew) {
 		idoPtr = (ItclDelegatedOption *)Tcl_Alloc(sizeof(ItclDelegatedOption));
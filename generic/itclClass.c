@@ -31,6 +31,7 @@
  * of this file, and for a DISCLAIMER OF ALL WARRANTIES.
  */
 #include "itclInt.h"
+#include <stdlib.h>
 
 static Tcl_NamespaceDeleteProc* _TclOONamespaceDeleteProc = NULL;
 static void ItclDeleteOption(char *cdata);
@@ -43,6 +44,7 @@ static void ItclFreeClass (void* cdata);
 static void ItclDeleteFunction(ItclMemberFunc *imPtr);
 static void ItclDeleteComponent(ItclComponent *icPtr);
 static void ItclDeleteOption(char *cdata);
+static void FreeIsa(ItclClass *iclsPtr);
 
 void
 ItclPreserveClass(
@@ -130,6 +132,7 @@ ItclDeleteClassMetadata(
 		(char *)ooNsPtr);
 	if (hPtr != NULL) {
 	    Tcl_DeleteHashEntry(hPtr);
+	    iclsPtr->infoPtr->accessEpoch++;
 	}
 	Tcl_DeleteNamespace(iclsPtr->nsPtr);
     } else {
@@ -285,6 +288,12 @@ Itcl_CreateClass(
     Tcl_InitObjHashTable(&iclsPtr->delegatedFunctions);
     Tcl_InitObjHashTable(&iclsPtr->methodVariables);
     Tcl_InitObjHashTable(&iclsPtr->resolveCmds);
+    Tcl_InitHashTable(&iclsPtr->resolveCmdNames, TCL_STRING_KEYS);
+    Tcl_InitHashTable(&iclsPtr->varSlotTable, TCL_ONE_WORD_KEYS);
+    Tcl_InitHashTable(&iclsPtr->optionSlotTable, TCL_ONE_WORD_KEYS);
+    Tcl_InitObjHashTable(&iclsPtr->optionDispatch);
+    Tcl_InitHashTable(&iclsPtr->delegateMethods, TCL_ONE_WORD_KEYS);
+    Tcl_InitHashTable(&iclsPtr->componentDelegations, TCL_ONE_WORD_KEYS);
 
     iclsPtr->numInstanceVars = 0;
     Tcl_InitHashTable(&iclsPtr->classCommons, TCL_ONE_WORD_KEYS);
@@ -411,6 +420,7 @@ Itcl_CreateClass(
     hPtr = Tcl_CreateHashEntry(&infoPtr->namespaceClasses, (char *)classNs,
 	    &newEntry);
     Tcl_SetHashValue(hPtr, iclsPtr);
+    infoPtr->accessEpoch++;
   if (classNs != ooNs) {
     hPtr = Tcl_CreateHashEntry(&infoPtr->namespaceClasses, (char *)ooNs,
 	    &newEntry);
@@ -579,7 +589,6 @@ CallDeleteOneObject(
     int result)
 {
     Tcl_HashEntry *hPtr;
-    Tcl_HashSearch place;
     ItclClass *iclsPtr2 = NULL;
     ItclObject *contextIoPtr;
     ItclClass *iclsPtr = (ItclClass *)data[0];
@@ -599,34 +608,24 @@ CallDeleteOneObject(
 	return result;
     }
     /*
-     * Fix 227804: Whenever an object to delete was found we
-     * have to reset the search to the beginning as the
-     * current entry in the search was deleted and accessing it
-     * is therefore not allowed anymore.
+     * Deleting the object takes it off the instance list of the
+     * class, so the next one to delete is always at the front.
      */
 
-    hPtr = Tcl_FirstHashEntry(&infoPtr->objects, &place);
-    if (hPtr) {
-	contextIoPtr = (ItclObject*)Tcl_GetHashValue(hPtr);
-
-	while (contextIoPtr->iclsPtr != iclsPtr) {
-	    hPtr = Tcl_NextHashEntry(&place);
-	    if (hPtr == NULL) {
-		break;
-	    }
-	}
-	if (hPtr) {
-	    callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
-	    if (Itcl_DeleteObject(interp, contextIoPtr) != TCL_OK) {
-		iclsPtr2 = iclsPtr;
-		goto deleteClassFail;
-	    }
-
-	    Tcl_NRAddCallback(interp, CallDeleteOneObject, iclsPtr,
-		    infoPtr, NULL, NULL);
-	    return Itcl_NRRunCallbacks(interp, callbackPtr);
+    contextIoPtr = iclsPtr->firstInstancePtr;
+    while ((contextIoPtr != NULL) && (contextIoPtr->accessCmd == NULL)) {
+	contextIoPtr = contextIoPtr->nextInstancePtr;
+    }
+    if (contextIoPtr != NULL) {
+	callbackPtr = Itcl_GetCurrentCallbackPtr(interp);
+	if (Itcl_DeleteObject(interp, contextIoPtr) != TCL_OK) {
+	    iclsPtr2 = iclsPtr;
+	    goto deleteClassFail;
 	}
 
+	Tcl_NRAddCallback(interp, CallDeleteOneObject, iclsPtr,
+		infoPtr, NULL, NULL);
+	return Itcl_NRRunCallbacks(interp, callbackPtr);
     }
 
     return TCL_OK;
@@ -819,8 +818,6 @@ void
 ItclDestroyClassNamesp(
     void *cdata)  /* class definition to be destroyed */
 {
-    Tcl_HashEntry *hPtr;
-    Tcl_HashSearch place;
     Tcl_Command cmdPtr;
     ItclClass *iclsPtr;
     ItclObject *ioPtr;
@@ -863,28 +860,23 @@ ItclDestroyClassNamesp(
      *  Scan through and find all objects that belong to this class.
      *  Destroy them quietly by deleting their access command.
      */
-    hPtr = Tcl_FirstHashEntry(&iclsPtr->infoPtr->objects, &place);
-    while (hPtr) {
-	ioPtr = (ItclObject*)Tcl_GetHashValue(hPtr);
-	if (ioPtr->iclsPtr == iclsPtr) {
-	    if ((ioPtr->accessCmd != NULL) && (!(ioPtr->flags &
-		    (ITCL_OBJECT_IS_DESTRUCTED)))) {
-		Itcl_PreserveData(ioPtr);
-		Tcl_DeleteCommandFromToken(iclsPtr->interp, ioPtr->accessCmd);
-		ioPtr->accessCmd = NULL;
-		Itcl_ReleaseData(ioPtr);
-		/*
-		 * Fix 227804: Whenever an object to delete was found we
-		 * have to reset the search to the beginning as the
-		 * current entry in the search was deleted and accessing it
-		 * is therefore not allowed anymore.
-		 */
+    ioPtr = iclsPtr->firstInstancePtr;
+    while (ioPtr) {
+	if ((ioPtr->accessCmd != NULL) && (!(ioPtr->flags &
+		(ITCL_OBJECT_IS_DESTRUCTED)))) {
+	    Itcl_PreserveData(ioPtr);
+	    Tcl_DeleteCommandFromToken(iclsPtr->interp, ioPtr->accessCmd);
+	    ioPtr->accessCmd = NULL;
+	    Itcl_ReleaseData(ioPtr);
+	    /*
+	     * Deleting an object may delete others as well, so
+	     * start over from the front of the instance list.
+	     */
 
-		hPtr = Tcl_FirstHashEntry(&iclsPtr->infoPtr->objects, &place);
-		continue;
-	    }
+	    ioPtr = iclsPtr->firstInstancePtr;
+	    continue;
 	}
-	hPtr = Tcl_NextHashEntry(&place);
+	ioPtr = ioPtr->nextInstancePtr;
     }
 
     /*
@@ -1023,6 +1015,21 @@ ItclFreeClass(
 	Tcl_DeleteHashEntry(hPtr);
     }
     Tcl_DeleteHashTable(&iclsPtr->resolveCmds);
+    Tcl_DeleteHashTable(&iclsPtr->resolveCmdNames);
+    Tcl_DeleteHashTable(&iclsPtr->varSlotTable);
+    if (iclsPtr->slotVars != NULL) {
+	Tcl_Free(iclsPtr->slotVars);
+    }
+    Tcl_DeleteHashTable(&iclsPtr->optionSlotTable);
+    ItclFreeOptionDispatch(iclsPtr);
+    Tcl_DeleteHashTable(&iclsPtr->optionDispatch);
+    ItclFreeMethodCache(iclsPtr);
+    ItclFreeInitPlan(iclsPtr);
+    ItclFreeLifecyclePlan(iclsPtr);
+    ItclFreePublicOpts(iclsPtr);
+    Tcl_DeleteHashTable(&iclsPtr->delegateMethods);
+    ItclFreeComponentDelegations(iclsPtr);
+    Tcl_DeleteHashTable(&iclsPtr->componentDelegations);
 
     /*
      *  Delete all option definitions.
@@ -1108,6 +1115,10 @@ ItclFreeClass(
     }
     Itcl_DeleteList(&iclsPtr->bases);
     Tcl_DeleteHashTable(&iclsPtr->heritage);
+    if (iclsPtr->mro != NULL) {
+	Tcl_Free(iclsPtr->mro);
+    }
+    FreeIsa(iclsPtr);
 
     /* remove owerself from the all classes entry */
     hPtr = Tcl_FindHashEntry(&iclsPtr->infoPtr->nameClasses,
@@ -1121,6 +1132,7 @@ ItclFreeClass(
 	    (char *)iclsPtr->nsPtr);
     if (hPtr != NULL) {
 	Tcl_DeleteHashEntry(hPtr);
+	iclsPtr->infoPtr->accessEpoch++;
     }
 
     /* remove owerself from the all classes entry */
@@ -1613,6 +1625,331 @@ ItclClassCreateObject(
 }
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclVarSpecialKind()
+ *
+ *  Classifies the built-in variables "this", "itcl_options" and
+ *  "itcl_option_components", which the runtime variable resolvers
+ *  bind directly to the handles cached in each ItclObject.  Returns
+ *  one of the ITCL_VAR_KIND_* values.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclVarSpecialKind(
+    ItclVariable *ivPtr)      /* variable definition */
+{
+    if (ivPtr->flags & ITCL_OPTIONS_VAR) {
+	return ITCL_VAR_KIND_OPTIONS;
+    }
+    if (ivPtr->flags & ITCL_OPTION_COMP_VAR) {
+	return ITCL_VAR_KIND_OPTION_COMPONENTS;
+    }
+    /* "thiswin" carries ITCL_THIS_VAR too, but is an ordinary variable */
+    if ((ivPtr->flags & ITCL_THIS_VAR)
+	    && (strcmp(Tcl_GetString(ivPtr->namePtr), "this") == 0)) {
+	return ITCL_VAR_KIND_THIS;
+    }
+    return ITCL_VAR_KIND_NORMAL;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  AddVarSlot()
+ *
+ *  Gives an instance variable the next slot in the layout of a class,
+ *  unless it already has one there.  Returns the slot of the variable.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Size
+AddVarSlot(
+    ItclClass *iclsPtr,       /* class whose layout is being built */
+    ItclVariable *ivPtr)      /* instance variable */
+{
+    Tcl_HashEntry *entry;
+    int isNew;
+
+    entry = Tcl_CreateHashEntry(&iclsPtr->varSlotTable, (char *)ivPtr,
+	    &isNew);
+    if (isNew) {
+	Tcl_SetHashValue(entry, INT2PTR(iclsPtr->numVarSlots));
+	iclsPtr->slotVars[iclsPtr->numVarSlots] = ivPtr;
+	iclsPtr->numVarSlots++;
+    }
+    return PTR2INT(Tcl_GetHashValue(entry));
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInitVarSlots()
+ *
+ *  Assigns a slot number to every instance variable in the hierarchy
+ *  of a class.  Each object of the class keeps its variables in an
+ *  array indexed by these numbers, so the runtime variable resolver
+ *  can fetch them without hashing.
+ *
+ *  The layout starts with the layout of the first base class, followed
+ *  by the variables of the class itself and then those of the other
+ *  base classes.  So a variable has the same slot in its own class and
+ *  in all classes derived from it through first base classes, and the
+ *  ItclVarLookup records of a class can keep that slot no matter which
+ *  of these classes the object belongs to.  The layout gets a unique
+ *  id, which objects use to tell whether their varSlots still follow
+ *  it.  Done when the first object of the class is created or a lookup
+ *  record needs the slot of one of its variables.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclInitVarSlots(
+    ItclClass *iclsPtr)       /* class definition being updated */
+{
+    Itcl_ListElem *elem;
+    ItclHierIter hier;
+    ItclClass *iclsPtr2;
+    ItclVariable *ivPtr;
+    FOREACH_HASH_DECLS;
+    Tcl_Size size;
+    Tcl_Size i;
+
+    if (iclsPtr->varSlotsId != 0) {
+	return;
+    }
+    size = 0;
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	size += iclsPtr2->variables.numEntries;
+    }
+    Itcl_DeleteHierIter(&hier);
+    if (size > 0) {
+	iclsPtr->slotVars = (ItclVariable **)Tcl_Alloc(
+		sizeof(ItclVariable *) * size);
+    }
+
+    elem = Itcl_FirstListElem(&iclsPtr->bases);
+    if (elem != NULL) {
+	iclsPtr2 = (ItclClass *)Itcl_GetListValue(elem);
+	ItclInitVarSlots(iclsPtr2);
+	for (i = 0; i < iclsPtr2->numVarSlots; i++) {
+	    AddVarSlot(iclsPtr, iclsPtr2->slotVars[i]);
+	}
+    }
+    FOREACH_HASH_VALUE(ivPtr, &iclsPtr->variables) {
+	if (!(ivPtr->flags & ITCL_COMMON)) {
+	    ivPtr->slotIndex = AddVarSlot(iclsPtr, ivPtr);
+	}
+    }
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	FOREACH_HASH_VALUE(ivPtr, &iclsPtr2->variables) {
+	    if (!(ivPtr->flags & ITCL_COMMON)) {
+		AddVarSlot(iclsPtr, ivPtr);
+	    }
+	}
+    }
+    Itcl_DeleteHierIter(&hier);
+    iclsPtr->varSlotsId = ++iclsPtr->infoPtr->varSlotsEpoch;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclVarSlotIndex()
+ *
+ *  Returns the slot of an instance variable in the layout of its own
+ *  class, laying out that class first if needed, or -1 for a common.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Size
+ItclVarSlotIndex(
+    ItclVariable *ivPtr)      /* variable definition */
+{
+    if (ivPtr->flags & ITCL_COMMON) {
+	return -1;
+    }
+    ItclInitVarSlots(ivPtr->iclsPtr);
+    return ivPtr->slotIndex;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclBuildPublicOpts()
+ *
+ *  Collects the public variables of the hierarchy of a class in the
+ *  order the "configure" method reports them, together with the
+ *  option names and initial values it reports.  Done once, when the
+ *  options of an object of the class are listed the first time.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclBuildPublicOpts(
+    ItclClass *iclsPtr)       /* class definition being updated */
+{
+    Tcl_HashEntry *entry;
+    ItclHierIter hier;
+    ItclClass *iclsPtr2;
+    ItclVariable *ivPtr;
+    ItclPublicOpt *optPtr;
+    FOREACH_HASH_DECLS;
+    Tcl_Size i;
+    Tcl_Size size;
+
+    if (iclsPtr->flags & ITCL_CLASS_PUBLIC_OPTS) {
+	return;
+    }
+    size = 0;
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	FOREACH_HASH_VALUE(ivPtr, &iclsPtr2->variables) {
+	    if (ivPtr->protection == ITCL_PUBLIC) {
+		size++;
+	    }
+	}
+    }
+    Itcl_DeleteHierIter(&hier);
+
+    iclsPtr->publicOpts = NULL;
+    if (size > 0) {
+	iclsPtr->publicOpts = (ItclPublicOpt *)Tcl_Alloc(
+		sizeof(ItclPublicOpt) * size);
+    }
+    i = 0;
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	FOREACH_HASH_VALUE(ivPtr, &iclsPtr2->variables) {
+	    if ((ivPtr->protection != ITCL_PUBLIC) || (i >= size)) {
+		continue;
+	    }
+	    entry = ItclResolveVarEntry(iclsPtr,
+		    Tcl_GetString(ivPtr->fullNamePtr));
+	    if (entry == NULL) {
+		continue;
+	    }
+	    optPtr = &iclsPtr->publicOpts[i++];
+	    optPtr->vlookup = (ItclVarLookup *)Tcl_GetHashValue(entry);
+	    optPtr->optionNamePtr = NULL;
+	    if (ivPtr->init != NULL) {
+		optPtr->initPtr = ivPtr->init;
+	    } else {
+		optPtr->initPtr = Tcl_NewStringObj("<undefined>", TCL_INDEX_NONE);
+	    }
+	    Tcl_IncrRefCount(optPtr->initPtr);
+	}
+    }
+    Itcl_DeleteHierIter(&hier);
+    iclsPtr->numPublicOpts = i;
+
+    /*
+     *  Take the names only now: resolving a shadowed variable may change
+     *  the least qualified name of the one it shadows.
+     */
+    for (i = 0; i < iclsPtr->numPublicOpts; i++) {
+	optPtr = &iclsPtr->publicOpts[i];
+	optPtr->optionNamePtr = Tcl_ObjPrintf("-%s",
+		optPtr->vlookup->leastQualName);
+	Tcl_IncrRefCount(optPtr->optionNamePtr);
+    }
+    iclsPtr->flags |= ITCL_CLASS_PUBLIC_OPTS;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreePublicOpts()
+ *
+ *  Releases what ItclBuildPublicOpts() collected for a class.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreePublicOpts(
+    ItclClass *iclsPtr)
+{
+    Tcl_Size i;
+
+    for (i = 0; i < iclsPtr->numPublicOpts; i++) {
+	Tcl_DecrRefCount(iclsPtr->publicOpts[i].optionNamePtr);
+	Tcl_DecrRefCount(iclsPtr->publicOpts[i].initPtr);
+    }
+    if (iclsPtr->publicOpts != NULL) {
+	Tcl_Free(iclsPtr->publicOpts);
+    }
+    iclsPtr->publicOpts = NULL;
+    iclsPtr->numPublicOpts = 0;
+    iclsPtr->flags &= ~ITCL_CLASS_PUBLIC_OPTS;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclComponentDelegations()
+ *
+ *  Returns the list of delegated methods of a class that go to the
+ *  given component, or NULL if there are none.  Methods excepting the
+ *  name of the component are left out, as for "delegate method *".
+ *  The lists are built for all components at once and again whenever
+ *  delegated methods were added to the class, which happens when an
+ *  unknown method is passed on by "delegate method *".
+ * ------------------------------------------------------------------------
+ */
+Itcl_List *
+ItclComponentDelegations(
+    ItclClass *iclsPtr,
+    ItclComponent *icPtr)
+{
+    FOREACH_HASH_DECLS;
+    ItclDelegatedFunction *idmPtr;
+    Itcl_List *listPtr;
+    int isNew;
+
+    if (iclsPtr->numComponentDelegations
+	    != iclsPtr->delegatedFunctions.numEntries) {
+	ItclFreeComponentDelegations(iclsPtr);
+	FOREACH_HASH_VALUE(idmPtr, &iclsPtr->delegatedFunctions) {
+	    if ((idmPtr->icPtr == NULL) || (Tcl_FindHashEntry(
+		    &idmPtr->exceptions, (char *)idmPtr->icPtr->namePtr)
+		    != NULL)) {
+		continue;
+	    }
+	    hPtr = Tcl_CreateHashEntry(&iclsPtr->componentDelegations,
+		    (char *)idmPtr->icPtr, &isNew);
+	    if (isNew) {
+		listPtr = (Itcl_List *)Tcl_Alloc(sizeof(Itcl_List));
+		Itcl_InitList(listPtr);
+		Tcl_SetHashValue(hPtr, listPtr);
+	    } else {
+		listPtr = (Itcl_List *)Tcl_GetHashValue(hPtr);
+	    }
+	    Itcl_AppendList(listPtr, idmPtr);
+	}
+	iclsPtr->numComponentDelegations =
+		iclsPtr->delegatedFunctions.numEntries;
+    }
+    hPtr = Tcl_FindHashEntry(&iclsPtr->componentDelegations, (char *)icPtr);
+    if (hPtr == NULL) {
+	return NULL;
+    }
+    return (Itcl_List *)Tcl_GetHashValue(hPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeComponentDelegations()
+ *
+ *  Releases the lists built by ItclComponentDelegations().
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeComponentDelegations(
+    ItclClass *iclsPtr)
+{
+    FOREACH_HASH_DECLS;
+    Itcl_List *listPtr;
+
+    FOREACH_HASH_VALUE(listPtr, &iclsPtr->componentDelegations) {
+	Itcl_DeleteList(listPtr);
+	Tcl_Free(listPtr);
+    }
+    Tcl_DeleteHashTable(&iclsPtr->componentDelegations);
+    Tcl_InitHashTable(&iclsPtr->componentDelegations, TCL_ONE_WORD_KEYS);
+    iclsPtr->numComponentDelegations = 0;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclResolveVarEntry()
@@ -1741,6 +2078,9 @@ ItclResolveVarEntry(
 			     */
 			    vlookup->accessible = (ivPtr->protection != ITCL_PRIVATE ||
 				    ivPtr->iclsPtr == iclsPtr);
+			    vlookup->specialKind = ItclVarSpecialKind(ivPtr);
+			    vlookup->slotIndex = ItclVarSlotIndex(ivPtr);
+			    vlookup->otherSlotsId = 0;
 
 			    /*
 			     *  Set aside the first object-specific slot for the built-in
@@ -1824,9 +2164,10 @@ ItclResolveVarEntry(
  *  removed from a class definition to rebuild the member lookup
  *  tables.  There are two tables:
  *
- *  METHODS:  resolveCmds
+ *  METHODS:  resolveCmds, resolveCmdNames
  *    Used primarily in Itcl_ClassCmdResolver() to resolve all
- *    command references in a namespace.
+ *    command references in a namespace.  resolveCmdNames holds the
+ *    same lookup records keyed by plain strings.
  *
  *  DATA MEMBERS:  resolveVars (built on demand, moved to ItclResolveVarEntry)
  *    Used primarily in Itcl_ClassVarResolver() to quickly resolve
@@ -1872,6 +2213,10 @@ Itcl_BuildVirtualTables(
     }
     Tcl_DeleteHashTable(&iclsPtr->resolveCmds);
     Tcl_InitObjHashTable(&iclsPtr->resolveCmds);
+    Tcl_DeleteHashTable(&iclsPtr->resolveCmdNames);
+    Tcl_InitHashTable(&iclsPtr->resolveCmdNames, TCL_STRING_KEYS);
+    iclsPtr->infoPtr->methodCacheEpoch++;
+    iclsPtr->infoPtr->accessEpoch++;
 
     /*
      *  Scan through all classes in the hierarchy, from most to
@@ -1910,6 +2255,9 @@ Itcl_BuildVirtualTables(
 		    memset(clookupPtr, 0, sizeof(ItclCmdLookup));
 		    clookupPtr->imPtr = imPtr;
 		    Tcl_SetHashValue(hPtr, clookupPtr);
+		    hPtr = Tcl_CreateHashEntry(&iclsPtr->resolveCmdNames,
+			    Tcl_DStringValue(bufferC), &newEntry);
+		    Tcl_SetHashValue(hPtr, clookupPtr);
 		} else {
 		    Tcl_DecrRefCount(objPtr);
 		}
@@ -2026,6 +2374,7 @@ Itcl_CreateVariable(
     ivPtr = (ItclVariable*)Itcl_Alloc(sizeof(ItclVariable));
     ivPtr->iclsPtr      = iclsPtr;
     ivPtr->infoPtr      = iclsPtr->infoPtr;
+    ivPtr->slotIndex    = -1;
     ivPtr->protection   = Itcl_Protection(interp, 0);
     ivPtr->codePtr      = mCodePtr;
     ivPtr->namePtr      = namePtr;
@@ -2051,6 +2400,12 @@ Itcl_CreateVariable(
     Itcl_PreserveData(ivPtr);
     Itcl_EventuallyFree(ivPtr, (Tcl_FreeProc *) Itcl_DeleteVariable);
 
+    /*
+     *  Objects created from now on need a slot and an init step for
+     *  the variable, e.g. after "itcl::addcomponent".
+     */
+    ItclResetObjectPlans(iclsPtr);
+
     *ivPtrPtr = ivPtr;
     return TCL_OK;
 }
@@ -2283,13 +2638,237 @@ Itcl_GetCommonVar(
 }
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  BuildMro()
+ *
+ *  Collects the class and its base classes into iclsPtr->mro, depth
+ *  first and from most-to-least specific.  A base class reached on
+ *  two paths is listed twice, "inherit" relies on that to report it.
+ * ------------------------------------------------------------------------
+ */
+static void
+BuildMro(
+    ItclClass *iclsPtr)   /* class definition */
+{
+    Itcl_Stack stack;
+    Itcl_ListElem *elem;
+    ItclClass *cdPtr;
+    Tcl_Size size;
+
+    size = 8;
+    iclsPtr->mro = (ItclClass **)Tcl_Alloc(size * sizeof(ItclClass *));
+    iclsPtr->numMro = 0;
+    Itcl_InitStack(&stack);
+    Itcl_PushStack(iclsPtr, &stack);
+    while ((cdPtr = (ItclClass *)Itcl_PopStack(&stack)) != NULL) {
+	if (iclsPtr->numMro == size) {
+	    size *= 2;
+	    iclsPtr->mro = (ItclClass **)Tcl_Realloc(iclsPtr->mro,
+		    size * sizeof(ItclClass *));
+	}
+	iclsPtr->mro[iclsPtr->numMro++] = cdPtr;
+
+	/*
+	 *  Push classes onto the stack in reverse order, so that
+	 *  they will be popped off in the proper order.
+	 */
+	elem = Itcl_LastListElem(&cdPtr->bases);
+	while (elem) {
+	    Itcl_PushStack(Itcl_GetListValue(elem), &stack);
+	    elem = Itcl_PrevListElem(elem);
+	}
+    }
+    Itcl_DeleteStack(&stack);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  BuildIsa()
+ *
+ *  Collects what ItclClassIsa() needs to know about the ancestors of a
+ *  class.  The chain of first base classes is copied from the first
+ *  base class and extended by the class itself, so an ancestor on that
+ *  chain is found at its own depth.  Ancestors reached through a
+ *  second or later base class are kept in a sorted array.
+ * ------------------------------------------------------------------------
+ */
+static int
+CompareClassPtrs(
+    const void *a,
+    const void *b)
+{
+    const ItclClass *c1 = *(ItclClass *const *)a;
+    const ItclClass *c2 = *(ItclClass *const *)b;
+
+    return (c1 < c2) ? -1 : (c1 > c2);
+}
+
+static void
+BuildIsa(
+    ItclClass *iclsPtr)   /* class definition */
+{
+    Itcl_ListElem *elem;
+    ItclClass *basePtr = NULL;
+    ItclClass *cdPtr;
+    Tcl_Size i;
+
+    elem = Itcl_FirstListElem(&iclsPtr->bases);
+    if (elem != NULL) {
+	basePtr = (ItclClass *)Itcl_GetListValue(elem);
+	if (basePtr->isaDisplay == NULL) {
+	    BuildIsa(basePtr);
+	}
+	iclsPtr->isaDepth = basePtr->isaDepth + 1;
+	iclsPtr->isaDisplay = (ItclClass **)Tcl_Alloc(
+		(iclsPtr->isaDepth + 1) * sizeof(ItclClass *));
+	memcpy(iclsPtr->isaDisplay, basePtr->isaDisplay,
+		iclsPtr->isaDepth * sizeof(ItclClass *));
+    } else {
+	iclsPtr->isaDepth = 0;
+	iclsPtr->isaDisplay = (ItclClass **)Tcl_Alloc(sizeof(ItclClass *));
+    }
+    iclsPtr->isaDisplay[iclsPtr->isaDepth] = iclsPtr;
+
+    if (Itcl_GetListLength(&iclsPtr->bases) < 2) {
+	if ((basePtr != NULL) && (basePtr->isaOthers != NULL)) {
+	    iclsPtr->numIsaOthers = basePtr->numIsaOthers;
+	    iclsPtr->isaOthers = (ItclClass **)Tcl_Alloc(
+		    iclsPtr->numIsaOthers * sizeof(ItclClass *));
+	    memcpy(iclsPtr->isaOthers, basePtr->isaOthers,
+		    iclsPtr->numIsaOthers * sizeof(ItclClass *));
+	}
+	return;
+    }
+
+    if (iclsPtr->mro == NULL) {
+	BuildMro(iclsPtr);
+    }
+    iclsPtr->isaOthers = (ItclClass **)Tcl_Alloc(
+	    iclsPtr->numMro * sizeof(ItclClass *));
+    iclsPtr->numIsaOthers = 0;
+    for (i = 0; i < iclsPtr->numMro; i++) {
+	cdPtr = iclsPtr->mro[i];
+	if (cdPtr->isaDisplay == NULL) {
+	    BuildIsa(cdPtr);
+	}
+	if ((cdPtr->isaDepth > iclsPtr->isaDepth)
+		|| (iclsPtr->isaDisplay[cdPtr->isaDepth] != cdPtr)) {
+	    iclsPtr->isaOthers[iclsPtr->numIsaOthers++] = cdPtr;
+	}
+    }
+    qsort(iclsPtr->isaOthers, iclsPtr->numIsaOthers, sizeof(ItclClass *),
+	    CompareClassPtrs);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  FreeIsa()
+ *
+ *  Forgets what BuildIsa() collected for a class.
+ * ------------------------------------------------------------------------
+ */
+static void
+FreeIsa(
+    ItclClass *iclsPtr)   /* class definition */
+{
+    if (iclsPtr->isaDisplay != NULL) {
+	Tcl_Free(iclsPtr->isaDisplay);
+	iclsPtr->isaDisplay = NULL;
+	iclsPtr->isaDepth = 0;
+    }
+    if (iclsPtr->isaOthers != NULL) {
+	Tcl_Free(iclsPtr->isaOthers);
+	iclsPtr->isaOthers = NULL;
+	iclsPtr->numIsaOthers = 0;
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclClassIsa()
+ *
+ *  Checks whether basePtr is the class iclsPtr itself or one of its
+ *  base classes.  For a base class on the chain of first base classes
+ *  this compares one entry of the chain, otherwise it searches the
+ *  few ancestors brought in by further base classes.  Returns non-zero
+ *  if so, and zero otherwise.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclClassIsa(
+    ItclClass *iclsPtr,   /* class being tested */
+    ItclClass *basePtr)   /* possible base class */
+{
+    Tcl_Size first, last, pos;
+
+    if (iclsPtr == basePtr) {
+	return 1;
+    }
+    if (iclsPtr->isaDisplay == NULL) {
+	BuildIsa(iclsPtr);
+    }
+    if (basePtr->isaDisplay == NULL) {
+	BuildIsa(basePtr);
+    }
+    if ((basePtr->isaDepth < iclsPtr->isaDepth)
+	    && (iclsPtr->isaDisplay[basePtr->isaDepth] == basePtr)) {
+	return 1;
+    }
+    first = 0;
+    last = iclsPtr->numIsaOthers - 1;
+    while (first <= last) {
+	pos = (first + last) / 2;
+	if (iclsPtr->isaOthers[pos] == basePtr) {
+	    return 1;
+	}
+	if (iclsPtr->isaOthers[pos] < basePtr) {
+	    first = pos + 1;
+	} else {
+	    last = pos - 1;
+	}
+    }
+    return 0;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclResetMro()
+ *
+ *  Forgets the mro of a class and of all classes derived from it.
+ *  Called when the base classes change; the next walk of the hierarchy
+ *  collects it again.  Cached access decisions are dropped as well.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclResetMro(
+    ItclClass *iclsPtr)   /* class definition */
+{
+    Itcl_ListElem *elem;
+
+    if (iclsPtr->mro != NULL) {
+	Tcl_Free(iclsPtr->mro);
+	iclsPtr->mro = NULL;
+	iclsPtr->numMro = 0;
+    }
+    FreeIsa(iclsPtr);
+    iclsPtr->infoPtr->accessEpoch++;
+    elem = Itcl_FirstListElem(&iclsPtr->derived);
+    while (elem) {
+	ItclResetMro((ItclClass *)Itcl_GetListValue(elem));
+	elem = Itcl_NextListElem(elem);
+    }
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_InitHierIter()
  *
  *  Initializes an iterator for traversing the hierarchy of the given
  *  class.  Subsequent calls to Itcl_AdvanceHierIter() will return
- *  the base classes in order from most-to-least specific.
+ *  the base classes in order from most-to-least specific.  The
+ *  iterator walks a copy of the mro of the class, which is collected
+ *  on the first walk.
  * ------------------------------------------------------------------------
  */
 void
@@ -2297,11 +2876,28 @@ Itcl_InitHierIter(
     ItclHierIter *iter,   /* iterator used for traversal */
     ItclClass *iclsPtr)   /* class definition for start of traversal */
 {
-    Itcl_InitStack(&iter->stack);
-    Itcl_PushStack(iclsPtr, &iter->stack);
+    if (iclsPtr->mro == NULL) {
+	BuildMro(iclsPtr);
+    }
+
+    /*
+     *  Walk a copy, ItclResetMro() may free the mro of the class while
+     *  the walk is still going on.
+     */
+    if (iclsPtr->numMro <= (Tcl_Size)(sizeof(iter->stack.space)
+	    / sizeof(void *))) {
+	iter->stack.values = iter->stack.space;
+    } else {
+	iter->stack.values = (void **)Tcl_Alloc(
+		iclsPtr->numMro * sizeof(void *));
+    }
+    memcpy(iter->stack.values, iclsPtr->mro,
+	    iclsPtr->numMro * sizeof(void *));
+    iter->stack.len = 0;
+    iter->stack.max = iclsPtr->numMro;
     iter->current = iclsPtr;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_DeleteHierIter()
@@ -2314,10 +2910,16 @@ void
 Itcl_DeleteHierIter(
     ItclHierIter *iter)  /* iterator used for traversal */
 {
-    Itcl_DeleteStack(&iter->stack);
+    if ((iter->stack.values != NULL)
+	    && (iter->stack.values != iter->stack.space)) {
+	Tcl_Free(iter->stack.values);
+    }
+    iter->stack.values = NULL;
+    iter->stack.len = 0;
+    iter->stack.max = 0;
     iter->current = NULL;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_AdvanceHierIter()
@@ -2331,26 +2933,14 @@ ItclClass*
 Itcl_AdvanceHierIter(
     ItclHierIter *iter)  /* iterator used for traversal */
 {
-    Itcl_ListElem *elem;
-    ItclClass *iclsPtr;
-
-    iter->current = (ItclClass*)Itcl_PopStack(&iter->stack);
-
-    /*
-     *  Push classes onto the stack in reverse order, so that
-     *  they will be popped off in the proper order.
-     */
-    if (iter->current) {
-	iclsPtr = (ItclClass*)iter->current;
-	elem = Itcl_LastListElem(&iclsPtr->bases);
-	while (elem) {
-	    Itcl_PushStack(Itcl_GetListValue(elem), &iter->stack);
-	    elem = Itcl_PrevListElem(elem);
-	}
+    if (iter->stack.len < iter->stack.max) {
+	iter->current = (ItclClass *)iter->stack.values[iter->stack.len++];
+    } else {
+	iter->current = NULL;
     }
     return iter->current;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_DeleteVariable()
@@ -2387,6 +2977,9 @@ Itcl_DeleteVariable(
     if (ivPtr->arrayInitPtr) {
 	Tcl_DecrRefCount(ivPtr->arrayInitPtr);
     }
+    if (ivPtr->flatNamePtr) {
+	Tcl_DecrRefCount(ivPtr->flatNamePtr);
+    }
     Itcl_Free(ivPtr);
 }
 
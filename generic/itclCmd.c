@@ -287,6 +287,58 @@ Itcl_FindClassesCmd(
 }
 
 
+/*
+ * ------------------------------------------------------------------------
+ *  AppendFoundObject()
+ *
+ *  Appends the name of an object to the result of "itcl::find objects"
+ *  if it matches the pattern.  Objects whose command lives in the
+ *  current namespace are reported by their short name, all others by
+ *  their full name, unless the pattern asks for full names.  The first
+ *  prefixLen characters of the pattern are literal, which rules out
+ *  most objects before their name is copied.
+ * ------------------------------------------------------------------------
+ */
+static void
+AppendFoundObject(
+    Tcl_Interp *interp,        /* current interpreter */
+    ItclObject *ioPtr,         /* object being reported */
+    Tcl_Namespace *activeNs,   /* current namespace */
+    int forceFullNames,        /* report full names only */
+    const char *pattern,       /* pattern or NULL to report all */
+    Tcl_Size prefixLen)        /* length of the literal pattern prefix */
+{
+    Tcl_CmdInfo cmdInfo;
+    const char *cmdName;
+    Tcl_Obj *objPtr;
+
+    if ((ioPtr->accessCmd == NULL) ||
+	    !Tcl_GetCommandInfoFromToken(ioPtr->accessCmd, &cmdInfo)) {
+	return;
+    }
+    if (!forceFullNames && (cmdInfo.namespacePtr == activeNs)) {
+	cmdName = Tcl_GetCommandName(interp, ioPtr->accessCmd);
+	if (pattern && ((strncmp(cmdName, pattern, prefixLen) != 0)
+		|| !Tcl_StringCaseMatch(cmdName, pattern, 0))) {
+	    return;
+	}
+	objPtr = Tcl_NewStringObj(cmdName, TCL_INDEX_NONE);
+    } else {
+	/* full names start with "::" */
+	if ((prefixLen > 0) && (pattern[0] != ':')) {
+	    return;
+	}
+	objPtr = Tcl_NewObj();
+	Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
+	if (pattern && !Tcl_StringCaseMatch(Tcl_GetString(objPtr),
+		pattern, 0)) {
+	    Tcl_DecrRefCount(objPtr);
+	    return;
+	}
+    }
+    Tcl_ListObjAppendElement(NULL, Tcl_GetObjResult(interp), objPtr);
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_FindObjectsCmd()
@@ -302,13 +354,13 @@ Itcl_FindClassesCmd(
  */
 int
 Itcl_FindObjectsCmd(
-    TCL_UNUSED(void *),      /* class/object info */
+    void *clientData,        /* class/object info */
     Tcl_Interp *interp,      /* current interpreter */
     int objc,		/* number of arguments */
     Tcl_Obj *const objv[])   /* argument objects */
 {
+    ItclObjectInfo *infoPtr = (ItclObjectInfo *)clientData;
     Tcl_Namespace *activeNs = Tcl_GetCurrentNamespace(interp);
-    Tcl_Namespace *globalNs = Tcl_GetGlobalNamespace(interp);
     int forceFullNames = 0;
 
     char *pattern = NULL;
@@ -317,21 +369,13 @@ Itcl_FindObjectsCmd(
 
     char *name = NULL;
     char *token = NULL;
-    const char *cmdName = NULL;
     int pos;
-    int newEntry;
-    int match;
-    int handledActiveNs;
+    Tcl_Size prefixLen;
+    FOREACH_HASH_DECLS;
+    ItclClass *iclsPtr2;
     ItclObject *contextIoPtr;
-    Tcl_HashTable unique;
-    Tcl_HashEntry *entry;
-    Tcl_HashSearch place;
-    Itcl_Stack search;
     Tcl_Command cmd;
-    Tcl_Command originalCmd;
     Tcl_CmdInfo cmdInfo;
-    Tcl_Namespace *nsPtr;
-    Tcl_Obj *objPtr;
 
     /*
      *  Parse arguments:
@@ -386,102 +430,68 @@ Itcl_FindObjectsCmd(
     }
 
     /*
-     *  Search through all commands in the current namespace first,
-     *  in the global namespace next, then in all child namespaces
-     *  in this interpreter.  If we find any commands that
-     *  represent objects, report them.
+     *  With -class, only the instances of that class can match, and
+     *  the class knows them.
      */
-
-    Itcl_InitStack(&search);
-    Itcl_PushStack(globalNs, &search);
-    Itcl_PushStack(activeNs, &search);  /* last in, first out! */
-
-    Tcl_InitHashTable(&unique, TCL_ONE_WORD_KEYS);
-
-    handledActiveNs = 0;
-    while (Itcl_GetStackSize(&search) > 0) {
-	nsPtr = (Tcl_Namespace *)Itcl_PopStack(&search);
-	if (nsPtr == activeNs && handledActiveNs) {
-	    continue;
+    if (iclsPtr != NULL) {
+	if ((isaDefn != NULL) && !ItclClassIsa(iclsPtr, isaDefn)) {
+	    return TCL_OK;
 	}
+	for (contextIoPtr = iclsPtr->firstInstancePtr; contextIoPtr != NULL;
+		contextIoPtr = contextIoPtr->nextInstancePtr) {
+	    AppendFoundObject(interp, contextIoPtr, activeNs, forceFullNames,
+		    pattern, 0);
+	}
+	return TCL_OK;
+    }
 
-	entry = Tcl_FirstHashEntry(Itcl_GetNamespaceCommandTable(nsPtr), &place);
-	while (entry) {
-	    cmd = (Tcl_Command)Tcl_GetHashValue(entry);
-	    if (Itcl_IsObject(cmd)) {
-		originalCmd = Tcl_GetOriginalCommand(cmd);
-		if (originalCmd) {
-		    cmd = originalCmd;
-		}
-		Tcl_GetCommandInfoFromToken(cmd, &cmdInfo);
-		contextIoPtr = (ItclObject*)cmdInfo.deleteData;
-
-		/*
-		 *  Report full names if:
-		 *  - the pattern has namespace qualifiers
-		 *  - the class namespace is not in the current namespace
-		 *  - the class's object creation command is imported from
-		 *      another namespace.
-		 *
-		 *  Otherwise, report short names.
-		 */
-		if (forceFullNames || nsPtr != activeNs ||
-		    originalCmd != NULL) {
-
-		    objPtr = Tcl_NewStringObj(NULL, 0);
-		    Tcl_GetCommandFullName(interp, cmd, objPtr);
-		    cmdName = Tcl_GetString(objPtr);
-		} else {
-		    cmdName = Tcl_GetCommandName(interp, cmd);
-		    objPtr = Tcl_NewStringObj((const char *)cmdName, TCL_INDEX_NONE);
-		}
-
-		Tcl_CreateHashEntry(&unique, (char*)cmd, &newEntry);
-
-		match = 0;
-		if (newEntry &&
-			(!pattern || Tcl_StringCaseMatch((const char *)cmdName,
-			pattern, 0))) {
-		    if ((iclsPtr == NULL) ||
-			    (contextIoPtr->iclsPtr == iclsPtr)) {
-			if (isaDefn == NULL) {
-			    match = 1;
-			} else {
-			    entry = Tcl_FindHashEntry(
-				&contextIoPtr->iclsPtr->heritage,
-				(char*)isaDefn);
-
-			    if (entry) {
-				match = 1;
-			    }
-			}
-		    }
-		}
-
-		if (match) {
-		    Tcl_ListObjAppendElement(NULL,
-			Tcl_GetObjResult(interp), objPtr);
-		} else {
-		    Tcl_DecrRefCount(objPtr);  /* throw away the name */
-		}
+    /*
+     *  A pattern without wildcards names at most one command.  Look
+     *  it up directly instead of checking every object.  Without
+     *  "::" it can only be the short name of an object in the current
+     *  namespace, with "::" only the full name of an object.
+     */
+    prefixLen = 0;
+    if (pattern != NULL) {
+	prefixLen = strcspn(pattern, "*?[\\");
+    }
+    if ((pattern != NULL) && (pattern[prefixLen] == '\0')) {
+	if (!forceFullNames) {
+	    cmd = Tcl_FindCommand(interp, pattern, activeNs,
+		    TCL_NAMESPACE_ONLY);
+	} else if ((pattern[0] == ':') && (pattern[1] == ':')) {
+	    cmd = Tcl_FindCommand(interp, pattern, NULL, TCL_GLOBAL_ONLY);
+	} else {
+	    cmd = NULL;
+	}
+	if ((cmd != NULL) && Itcl_IsObject(cmd)
+		&& (Tcl_GetOriginalCommand(cmd) == NULL)
+		&& Tcl_GetCommandInfoFromToken(cmd, &cmdInfo)) {
+	    contextIoPtr = (ItclObject *)cmdInfo.deleteData;
+	    if ((isaDefn == NULL)
+		    || ItclClassIsa(contextIoPtr->iclsPtr, isaDefn)) {
+		AppendFoundObject(interp, contextIoPtr, activeNs,
+			forceFullNames, pattern, prefixLen);
 	    }
-	    entry = Tcl_NextHashEntry(&place);
 	}
-	handledActiveNs = 1;  /* don't process the active namespace twice */
+	return TCL_OK;
+    }
 
-	/*
-	 *  Push any child namespaces onto the stack and continue
-	 *  the search in those namespaces.
-	 */
-	entry = Tcl_FirstHashEntry(Itcl_GetNamespaceChildTable(nsPtr), &place);
-	while (entry != NULL) {
-	    Itcl_PushStack(Tcl_GetHashValue(entry), &search);
-	    entry = Tcl_NextHashEntry(&place);
+    /*
+     *  Otherwise check the instances of every class, or with -isa of
+     *  every class that inherits from that class.  This visits each
+     *  object once, no matter how many other commands the interp has.
+     */
+    FOREACH_HASH_VALUE(iclsPtr2, &infoPtr->classes) {
+	if ((isaDefn != NULL) && !ItclClassIsa(iclsPtr2, isaDefn)) {
+	    continue;
+	}
+	for (contextIoPtr = iclsPtr2->firstInstancePtr; contextIoPtr != NULL;
+		contextIoPtr = contextIoPtr->nextInstancePtr) {
+	    AppendFoundObject(interp, contextIoPtr, activeNs, forceFullNames,
+		    pattern, prefixLen);
 	}
     }
-    Tcl_DeleteHashTable(&unique);
-    Itcl_DeleteStack(&search);
-
     return TCL_OK;
 }
 
@@ -809,20 +819,16 @@ Itcl_ScopeCmd(
 	    }
 	}
 
-	objPtr2 = Tcl_NewStringObj(NULL, 0);
-	Tcl_IncrRefCount(objPtr2);
-	Tcl_AppendToObj(objPtr2, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-	Tcl_AppendToObj(objPtr2,
-		(Tcl_GetObjectNamespace(contextIoPtr->oPtr))->fullName, TCL_INDEX_NONE);
-
 	if (doAppend) {
-	    Tcl_AppendToObj(objPtr2,
-		    Tcl_GetString(vlookup->ivPtr->fullNamePtr), TCL_INDEX_NONE);
+	    objPtr2 = ItclScopedVarName(interp, contextIoPtr,
+		    vlookup->ivPtr);
 	} else {
+	    objPtr2 = Tcl_DuplicateObj(contextIoPtr->varNsNamePtr);
 	    Tcl_AppendToObj(objPtr2, "::", TCL_INDEX_NONE);
 	    Tcl_AppendToObj(objPtr2,
 		    Tcl_GetString(vlookup->ivPtr->namePtr), TCL_INDEX_NONE);
 	}
+	Tcl_IncrRefCount(objPtr2);
 
 	if (openParen) {
 	    *openParen = '(';
@@ -1416,9 +1422,11 @@ Itcl_AddOptionCmd(
     int objc,		/* number of arguments */
     Tcl_Obj *const objv[])   /* argument objects */
 {
-    Tcl_HashEntry *hPtr;
+    FOREACH_HASH_DECLS;
     ItclObjectInfo *infoPtr;
     ItclClass *iclsPtr;
+    ItclClass *iclsPtr2;
+    ItclObject *ioPtr;
     const char *protectionStr;
     int pLevel;
     int result;
@@ -1460,6 +1468,19 @@ Itcl_AddOptionCmd(
     if (result != TCL_OK) {
 	return result;
     }
+    /*
+     *  The option tables of derived classes may include the new option,
+     *  while existing objects keep the options they were created with.
+     */
+    FOREACH_HASH_VALUE(iclsPtr2, &infoPtr->nameClasses) {
+	ItclFreeOptionDispatch(iclsPtr2);
+    }
+    FOREACH_HASH_VALUE(ioPtr, &infoPtr->objects) {
+	if (ioPtr->flags & ITCL_OBJECT_CLASS_OPTIONS) {
+	    ioPtr->flags &= ~ITCL_OBJECT_CLASS_OPTIONS;
+	    ioPtr->flags |= ITCL_OBJECT_OWN_OPTIONS;
+	}
+    }
     result = DelegatedOptionsInstall(interp, iclsPtr);
     return result;
 }
@@ -1551,9 +1572,11 @@ Itcl_AddObjectOptionCmd(
     Tcl_AppendToObj(ioptPtr->fullNamePtr, "::", 2);
     Tcl_AppendToObj(ioptPtr->fullNamePtr, Tcl_GetString(ioptPtr->namePtr), TCL_INDEX_NONE);
     Tcl_IncrRefCount(ioptPtr->fullNamePtr);
-    hPtr = Tcl_CreateHashEntry(&ioPtr->objectOptions,
+    hPtr = Tcl_CreateHashEntry(&ItclGetObjectExt(ioPtr)->objectOptions,
 	    (char *)ioptPtr->namePtr, &isNew);
     Tcl_SetHashValue(hPtr, ioptPtr);
+    ioPtr->flags |= ITCL_OBJECT_OWN_OPTIONS;
+    ioPtr->flags &= ~ITCL_OBJECT_CLASS_OPTIONS;
     ItclSetInstanceVar(interp, "itcl_options",
 	    Tcl_GetString(ioptPtr->namePtr),
 	    Tcl_GetString(ioptPtr->defaultValuePtr), ioPtr, NULL);
@@ -1614,9 +1637,11 @@ Itcl_AddDelegatedOptionCmd(
     if (result != TCL_OK) {
 	return result;
     }
-    hPtr = Tcl_CreateHashEntry(&ioPtr->objectDelegatedOptions,
+    hPtr = Tcl_CreateHashEntry(&ItclGetObjectExt(ioPtr)->objectDelegatedOptions,
 	    (char *)idoPtr->namePtr, &isNew);
     Tcl_SetHashValue(hPtr, idoPtr);
+    ioPtr->flags |= ITCL_OBJECT_OWN_OPTIONS;
+    ioPtr->flags &= ~ITCL_OBJECT_CLASS_OPTIONS;
     return result;
 }
 
@@ -1693,7 +1718,7 @@ Itcl_AddDelegatedFunctionCmd(
     componentNamePtr = Tcl_NewStringObj(val, TCL_INDEX_NONE);
     Tcl_IncrRefCount(componentNamePtr);
     DelegateFunction(interp, ioPtr, ioPtr->iclsPtr, componentNamePtr, idmPtr);
-    hPtr = Tcl_CreateHashEntry(&ioPtr->objectDelegatedFunctions,
+    hPtr = Tcl_CreateHashEntry(&ItclGetObjectExt(ioPtr)->objectDelegatedFunctions,
 	    (char *)idmPtr->namePtr, &isNew);
     Tcl_DecrRefCount(componentNamePtr);
     Tcl_SetHashValue(hPtr, idmPtr);
@@ -1751,7 +1776,7 @@ Itcl_AddComponentCmd(
 	return TCL_ERROR;
     }
     contextIclsPtr = contextIoPtr->iclsPtr;
-    hPtr = Tcl_CreateHashEntry(&contextIoPtr->objectComponents, (char *)objv[2],
+    hPtr = Tcl_CreateHashEntry(&ItclGetObjectExt(contextIoPtr)->objectComponents, (char *)objv[2],
 	    &isNew);
     if (!isNew) {
 	Tcl_AppendResult(interp, "Itcl_AddComponentCmd component \"",
@@ -1792,6 +1817,9 @@ Itcl_AddComponentCmd(
      */
     vlookup->accessible = (ivPtr->protection != ITCL_PRIVATE ||
 	ivPtr->iclsPtr == contextIclsPtr);
+    vlookup->specialKind = ItclVarSpecialKind(ivPtr);
+    vlookup->slotIndex = ItclVarSlotIndex(ivPtr);
+    vlookup->otherSlotsId = 0;
 
     vlookup->varNum = contextIclsPtr->numInstanceVars++;
     /*
@@ -31,6 +31,7 @@
  * of this file, and for a DISCLAIMER OF ALL WARRANTIES.
  */
 #include "itclInt.h"
+#include <stdlib.h>
 
 #define ITCL_ENSEMBLE_CUSTOM        0x01
 #define ITCL_ENSEMBLE_ENSEMBLE      0x02
@@ -56,10 +57,18 @@ typedef struct EnsemblePart {
     Tcl_Obj *mapNamePtr;
     Tcl_Obj *subEnsemblePtr;
     Tcl_Obj *newMapDict;
+    void *methodPtr;            /* method record used to invoke the
+				 * proc of a part, made on first call */
 } EnsemblePart;
 
 #define ENSEMBLE_DELETE_STARTED      0x1
 #define ENSEMBLE_PART_DELETE_STARTED 0x2
+#define ENSEMBLE_BULK_ADD            0x4  /* parts appended unsorted while
+					   * an "ensemble" body is parsed */
+#define ENSEMBLE_PARTS_UNSORTED      0x8  /* parts list needs sorting and
+					   * minChars need computing */
+#define ENSEMBLE_MAP_PENDING         0x10 /* mapping dict changed but not
+					   * yet handed back to Tcl */
 
 /*
  *  Data used to represent an ensemble:
@@ -76,6 +85,8 @@ typedef struct Ensemble {
     Tcl_Namespace *nsPtr;       /* namespace for ensemble part commands */
     int flags;
     Tcl_Obj *namePtr;
+    Tcl_HashTable partTable;    /* parts by exact name, so that full
+				 * names are found without searching */
 } Ensemble;
 
 /*
@@ -114,6 +125,8 @@ static void DeleteEnsemble(void *clientData);
 static int FindEnsemblePartIndex (Ensemble *ensData,
     const char *partName, int *posPtr);
 static void ComputeMinChars (Ensemble *ensData, int pos);
+static void SortEnsembleParts (Ensemble *ensData);
+static void FinishEnsembleParts (Ensemble *ensData);
 static EnsembleParser* GetEnsembleParser (Tcl_Interp *interp);
 static void DeleteEnsParser (void *clientData, Tcl_Interp* interp);
 
@@ -665,6 +678,7 @@ GetEnsembleUsage(
     int i;
     EnsemblePart *ensPart;
 
+    SortEnsembleParts(ensData);
     for (i=0; i < ensData->numParts; i++) {
 	ensPart = ensData->parts[i];
 
@@ -828,6 +842,7 @@ CreateEnsemble(
 	(unsigned)(ensData->maxParts*sizeof(EnsemblePart*))
     );
     memset(ensData->parts, 0, ensData->maxParts*sizeof(EnsemblePart*));
+    Tcl_InitHashTable(&ensData->partTable, TCL_STRING_KEYS);
     Tcl_DStringInit(&buffer);
     Tcl_DStringAppend(&buffer, ITCL_COMMANDS_NAMESPACE "::ensembles::", TCL_INDEX_NONE);
     sprintf(buf, "%" TCL_SIZE_MODIFIER "u", ensData->ensembleId);
@@ -1010,7 +1025,17 @@ AddEnsemblePart(
 	Tcl_DecrRefCount(ensPart->mapNamePtr);
 	return TCL_ERROR;
     }
-    Tcl_SetEnsembleMappingDict(interp, ensData->cmdPtr, mapDict);
+
+    /*
+     *  While an "ensemble" body is being parsed, Tcl only needs to
+     *  see the finished map.  Handing it over for every part would
+     *  revalidate the whole map each time.
+     */
+    if ((ensData->flags & ENSEMBLE_BULK_ADD) && ensPart->newMapDict == NULL) {
+	ensData->flags |= ENSEMBLE_MAP_PENDING;
+    } else {
+	Tcl_SetEnsembleMappingDict(interp, ensData->cmdPtr, mapDict);
+    }
     *rVal = ensPart;
     return TCL_OK;
 }
@@ -1060,6 +1085,7 @@ DeleteEnsemble(
     Tcl_Free(ensData->parts);
     ensData->parts = NULL;
     ensData->numParts = 0;
+    Tcl_DeleteHashTable(&ensData->partTable);
     infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(ensData->interp, ITCL_INTERP_DATA, NULL);
     FOREACH_HASH_VALUE(ensData2, &infoPtr->ensembleInfo->ensembles) {
 	if (ensData2 == ensData) {
@@ -1209,19 +1235,33 @@ CreateEnsemblePart(
     int i;
     int pos;
     int size;
+    int isNew;
+    Tcl_HashEntry *hPtr;
     EnsemblePart** partList;
     EnsemblePart* ensPart;
 
     /*
      *  If a matching entry was found, then return an error.
      */
-    if (FindEnsemblePartIndex(ensData, partName, &pos)) {
+    hPtr = Tcl_CreateHashEntry(&ensData->partTable, partName, &isNew);
+    if (!isNew) {
 	Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
 	    "part \"", partName, "\" already exists in ensemble",
 	    (char *)NULL);
 	return TCL_ERROR;
     }
 
+    /*
+     *  While an "ensemble" body is being parsed, just append the
+     *  part.  The list is sorted once when the body is finished.
+     */
+    if (ensData->flags & ENSEMBLE_BULK_ADD) {
+	pos = ensData->numParts;
+	ensData->flags |= ENSEMBLE_PARTS_UNSORTED;
+    } else {
+	FindEnsemblePartIndex(ensData, partName, &pos);
+    }
+
     /*
      *  Otherwise, make room for a new entry.  Keep the parts in
      *  lexicographical order, so we can search them quickly
@@ -1251,6 +1291,7 @@ CreateEnsemblePart(
     ensPart->interp = interp;
 
     ensData->parts[pos] = ensPart;
+    Tcl_SetHashValue(hPtr, ensPart);
 
     /*
      *  Compare the new part against the one on either side of
@@ -1259,9 +1300,11 @@ CreateEnsemblePart(
      *  the parts on either side as well, since they are influenced
      *  by the new part.
      */
-    ComputeMinChars(ensData, pos);
-    ComputeMinChars(ensData, pos-1);
-    ComputeMinChars(ensData, pos+1);
+    if (!(ensData->flags & ENSEMBLE_PARTS_UNSORTED)) {
+	ComputeMinChars(ensData, pos);
+	ComputeMinChars(ensData, pos-1);
+	ComputeMinChars(ensData, pos+1);
+    }
 
     *ensPartPtr = ensPart;
     return TCL_OK;
@@ -1352,6 +1395,10 @@ DeleteEnsemblePart(
 	    ensData->parts[i] = ensData->parts[i+1];
 	}
 	ensData->numParts--;
+	hPtr = Tcl_FindHashEntry(&ensData->partTable, ensPart->name);
+	if (hPtr != NULL) {
+	    Tcl_DeleteHashEntry(hPtr);
+	}
     }
 
     /*
@@ -1377,6 +1424,9 @@ DeleteEnsemblePart(
     if (ensPart->usage != NULL) {
 	Tcl_Free(ensPart->usage);
     }
+    if (ensPart->methodPtr != NULL) {
+	Tcl_Free(ensPart->methodPtr);
+    }
     Tcl_Free(ensPart->name);
     Tcl_Free(ensPart);
 }
@@ -1412,8 +1462,20 @@ FindEnsemblePart(
     int pos = 0;
     int first, last, nlen;
     int i, cmp;
+    Tcl_HashEntry *hPtr;
 
+    /*
+     *  A full part name always wins, even if it is also the
+     *  prefix of another part.  Only fall back on abbreviations
+     *  when there is no exact match.
+     */
+    hPtr = Tcl_FindHashEntry(&ensData->partTable, partName);
+    if (hPtr != NULL) {
+	*rensPart = (EnsemblePart *)Tcl_GetHashValue(hPtr);
+	return TCL_OK;
+    }
     *rensPart = NULL;
+    SortEnsembleParts(ensData);
 
     /*
      *  Search for the desired part name.
@@ -1528,6 +1590,8 @@ FindEnsemblePartIndex(
     int first, last;
     int cmp;
 
+    SortEnsembleParts(ensData);
+
     /*
      *  Search for the desired part name.
      *  All parts are in lexicographical order, so use a
@@ -1640,6 +1704,86 @@ ComputeMinChars(
     }
 }
 
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * SortEnsembleParts --
+ *
+ *      Restores the lexicographical order of an ensemble's part
+ *      list after parts were appended in bulk, and recomputes the
+ *      minimum abbreviation of every part in a single pass.
+ *
+ * Results:
+ *      None.
+ *
+ * Side effects:
+ *      Reorders the part list if it was marked unsorted.
+ *
+ *----------------------------------------------------------------------
+ */
+static int
+ComparePartNames(
+    const void *a,
+    const void *b)
+{
+    return strcmp((*(EnsemblePart *const *)a)->name,
+	    (*(EnsemblePart *const *)b)->name);
+}
+
+static void
+SortEnsembleParts(
+    Ensemble *ensData)        /* ensemble being modified */
+{
+    int i;
+
+    if (!(ensData->flags & ENSEMBLE_PARTS_UNSORTED)) {
+	return;
+    }
+    ensData->flags &= ~ENSEMBLE_PARTS_UNSORTED;
+    qsort(ensData->parts, ensData->numParts, sizeof(EnsemblePart *),
+	    ComparePartNames);
+    for (i=0; i < ensData->numParts; i++) {
+	ComputeMinChars(ensData, i);
+    }
+}
+
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * FinishEnsembleParts --
+ *
+ *      Ends a bulk update started by Itcl_EnsembleCmd.  Sorts the
+ *      parts that were appended and hands the mapping dict to Tcl
+ *      once for the whole batch.
+ *
+ * Results:
+ *      None.
+ *
+ * Side effects:
+ *      Updates the ensemble command's mapping dict.
+ *
+ *----------------------------------------------------------------------
+ */
+static void
+FinishEnsembleParts(
+    Ensemble *ensData)        /* ensemble being modified */
+{
+    Tcl_Obj *mapDict;
+
+    ensData->flags &= ~ENSEMBLE_BULK_ADD;
+    SortEnsembleParts(ensData);
+    if (ensData->flags & ENSEMBLE_MAP_PENDING) {
+	ensData->flags &= ~ENSEMBLE_MAP_PENDING;
+	mapDict = NULL;
+	Tcl_GetEnsembleMappingDict(NULL, ensData->cmdPtr, &mapDict);
+	if (mapDict != NULL) {
+	    Tcl_SetEnsembleMappingDict(NULL, ensData->cmdPtr, mapDict);
+	}
+    }
+}
+
 
 /*
  *----------------------------------------------------------------------
@@ -1679,6 +1823,7 @@ Itcl_EnsembleCmd(
     Tcl_Obj *const objv[])   /* argument objects */
 {
     int status;
+    int isBulk;
     char *ensName;
     EnsembleParser *ensInfo;
     Ensemble *ensData;
@@ -1794,6 +1939,17 @@ Itcl_EnsembleCmd(
     savedEnsData = ensInfo->ensData;
     ensInfo->ensData = ensData;
 
+    /*
+     *  Collect the parts added by the body and sort them once at
+     *  the end, rather than keeping the list sorted part by part.
+     *  A nested body for the same ensemble leaves this to the
+     *  outermost one.
+     */
+    isBulk = !(ensData->flags & ENSEMBLE_BULK_ADD);
+    if (isBulk) {
+	ensData->flags |= ENSEMBLE_BULK_ADD;
+    }
+
     if (objc == 3) {
 	status = Tcl_EvalObjEx(ensInfo->parser, objv[2], 0);
     } else {
@@ -1828,6 +1984,9 @@ Itcl_EnsembleCmd(
     }
     Tcl_SetObjResult(interp, Tcl_GetObjResult(ensInfo->parser));
 
+    if (isBulk) {
+	FinishEnsembleParts(ensData);
+    }
     ensInfo->ensData = savedEnsData;
     return status;
 }
@@ -2107,8 +2266,12 @@ CallInvokeEnsembleMethod(
     size_t objc = PTR2INT(data[2]);
     Tcl_Obj *const *objv = (Tcl_Obj *const *)data[3];
 
+    if (ensPart->methodPtr == NULL) {
+	ensPart->methodPtr = Itcl_NewEnsembleMethod(
+		(Tcl_Proc)ensPart->clientData);
+    }
     result = Itcl_InvokeEnsembleMethod(interp, nsPtr, ensPart->namePtr,
-		(Tcl_Proc *)ensPart->clientData, objc, objv);
+		ensPart->methodPtr, objc, objv);
     return result;
 }
 
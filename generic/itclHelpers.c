@@ -621,12 +621,8 @@ ItclDeleteClassesDictInfo(
 	    ITCL_NAMESPACE"::internal::dicts::classOptions");
     DeleteClassDictInfo(interp, iclsPtr,
 	    ITCL_NAMESPACE"::internal::dicts::classDelegatedOptions");
-    DeleteClassDictInfo(interp, iclsPtr,
-	    ITCL_NAMESPACE"::internal::dicts::classVariables");
     DeleteClassDictInfo(interp, iclsPtr,
 	    ITCL_NAMESPACE"::internal::dicts::classComponents");
-    DeleteClassDictInfo(interp, iclsPtr,
-	    ITCL_NAMESPACE"::internal::dicts::classFunctions");
     DeleteClassDictInfo(interp, iclsPtr,
 	    ITCL_NAMESPACE"::internal::dicts::classDelegatedFunctions");
     return TCL_OK;
@@ -634,48 +630,20 @@ ItclDeleteClassesDictInfo(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclAddObjectsDictInfo()
+ *  ObjectDictInfo()
+ *
+ *  Fills "valuePtr2" with the ::itcl::internal::dicts::objects entry
+ *  for a fully constructed object.
  * ------------------------------------------------------------------------
  */
-int
-ItclAddObjectsDictInfo(
+static int
+ObjectDictInfo(
     Tcl_Interp *interp,
-    ItclObject *ioPtr)
+    ItclObject *ioPtr,
+    Tcl_Obj *valuePtr2)
 {
-    Tcl_Obj *dictPtr;
-    Tcl_Obj *keyPtr;
-    Tcl_Obj *keyPtr1;
-    Tcl_Obj *valuePtr1;
-    Tcl_Obj *valuePtr2;
     Tcl_Obj *objPtr;
-    int newValue1;
 
-    dictPtr = Tcl_GetVar2Ex(interp,
-	     ITCL_NAMESPACE"::internal::dicts::objects", NULL, 0);
-    if (dictPtr == NULL) {
-	Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-		"::internal::dicts::objects", (char *)NULL);
-	return TCL_ERROR;
-    }
-    keyPtr1 = Tcl_NewStringObj("instances", TCL_INDEX_NONE);
-    if (Tcl_DictObjGet(interp, dictPtr, keyPtr1, &valuePtr1) != TCL_OK) {
-	return TCL_ERROR;
-    }
-    newValue1 = 0;
-    if (valuePtr1 == NULL) {
-	newValue1 = 1;
-	valuePtr1 = Tcl_NewDictObj();
-    }
-    keyPtr = ioPtr->namePtr;
-    if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
-	return TCL_ERROR;
-    }
-    if (valuePtr2 == NULL) {
-	if (Tcl_DictObjRemove(interp, valuePtr1, keyPtr) != TCL_OK) {
-	    return TCL_ERROR;
-	}
-    }
-    valuePtr2 = Tcl_NewDictObj();
     if (AddDictEntry(interp, valuePtr2, "-name", ioPtr->namePtr) != TCL_OK) {
 	return TCL_ERROR;
     }
@@ -703,82 +671,9 @@ ItclAddObjectsDictInfo(
 	Tcl_DecrRefCount(objPtr);
 	return TCL_ERROR;
     }
-    keyPtr = ioPtr->namePtr;
-    if (Tcl_DictObjPut(interp, valuePtr1, keyPtr, valuePtr2) != TCL_OK) {
-	return TCL_ERROR;
-    }
-    if (newValue1) {
-	/* Cannot fail. Screened non-dicts earlier. */
-	Tcl_DictObjPut(interp, dictPtr, keyPtr1, valuePtr1);
-    } else {
-	/* Don't leak the key val... */
-	Tcl_DecrRefCount(keyPtr1);
-    }
-    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::objects",
-	    NULL, dictPtr, 0);
     return TCL_OK;
 }
-
-/*
- * ------------------------------------------------------------------------
- *  ItclDeleteObjectsDictInfo()
- * ------------------------------------------------------------------------
- */
-int
-ItclDeleteObjectsDictInfo(
-    Tcl_Interp *interp,
-    ItclObject *ioPtr)
-{
-    Tcl_Obj *dictPtr;
-    Tcl_Obj *keyPtr;
-    Tcl_Obj *keyPtr1;
-    Tcl_Obj *valuePtr;
-    Tcl_Obj *valuePtr1;
 
-    dictPtr = Tcl_GetVar2Ex(interp,
-	     ITCL_NAMESPACE"::internal::dicts::objects", NULL, 0);
-    if (dictPtr == NULL) {
-	Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-		"::internal::dicts::objects", (char *)NULL);
-	return TCL_ERROR;
-    }
-    keyPtr1 = Tcl_NewStringObj("instances", TCL_INDEX_NONE);
-    if (Tcl_DictObjGet(interp, dictPtr, keyPtr1, &valuePtr) != TCL_OK) {
-	Tcl_DecrRefCount(keyPtr1);
-	return TCL_ERROR;
-    }
-    if (valuePtr == NULL) {
-	/* looks like no object has been registered yet
-	 * so ignore and return OK */
-	Tcl_DecrRefCount(keyPtr1);
-	return TCL_OK;
-    }
-    keyPtr = ioPtr->namePtr;
-    if (Tcl_DictObjGet(interp, valuePtr, keyPtr, &valuePtr1) != TCL_OK) {
-	Tcl_DecrRefCount(keyPtr1);
-	return TCL_ERROR;
-    }
-    if (valuePtr1 == NULL) {
-	/* looks like the object has not been constructed successfully
-	 * so ignore and return OK */
-	Tcl_DecrRefCount(keyPtr1);
-	return TCL_OK;
-    }
-    if (Tcl_DictObjRemove(interp, valuePtr, keyPtr) != TCL_OK) {
-	Tcl_DecrRefCount(keyPtr1);
-	return TCL_ERROR;
-    }
-    if (Tcl_DictObjPut(interp, dictPtr, keyPtr1, valuePtr) != TCL_OK) {
-	/* This is very likely impossible. non-dict already screened. */
-	Tcl_DecrRefCount(keyPtr1);
-	return TCL_ERROR;
-    }
-    Tcl_DecrRefCount(keyPtr1);
-    Tcl_SetVar2Ex(interp, ITCL_NAMESPACE"::internal::dicts::objects",
-	    NULL, dictPtr, 0);
-    return TCL_OK;
-}
-
 /*
  * ------------------------------------------------------------------------
  *  ItclAddOptionDictInfo()
@@ -1098,47 +993,39 @@ ItclAddClassComponentDictInfo(
 /*
  * ------------------------------------------------------------------------
  *  ItclAddClassVariableDictInfo()
+ *
+ *  Marks a class variable for ::itcl::internal::dicts::classVariables.
+ *  The dict itself is only built when a script reads it; see
+ *  ItclTraceDictsVar().
  * ------------------------------------------------------------------------
  */
 int
 ItclAddClassVariableDictInfo(
-    Tcl_Interp *interp,
-    ItclClass *iclsPtr,
+    TCL_UNUSED(Tcl_Interp *),
+    TCL_UNUSED(ItclClass *),
     ItclVariable *ivPtr)
 {
-    Tcl_Obj *dictPtr;
-    Tcl_Obj *keyPtr;
-    Tcl_Obj *valuePtr1;
-    Tcl_Obj *valuePtr2;
+    ivPtr->flags |= ITCL_DICT_INFO;
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ClassVariableDictInfo()
+ *
+ *  Fills "valuePtr2" with the classVariables entry for "ivPtr".
+ * ------------------------------------------------------------------------
+ */
+static int
+ClassVariableDictInfo(
+    Tcl_Interp *interp,
+    ItclVariable *ivPtr,
+    Tcl_Obj *valuePtr2)
+{
     Tcl_Obj *listPtr;
     const char *cp;
     int haveFlags;
-    int newValue1;
 
-    keyPtr = iclsPtr->fullNamePtr;
-    dictPtr = Tcl_GetVar2Ex(interp,
-	     ITCL_NAMESPACE"::internal::dicts::classVariables",
-	     NULL, TCL_GLOBAL_ONLY);
-    if (dictPtr == NULL) {
-	Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-		"::internal::dicts::classVariables", (char *)NULL);
-	return TCL_ERROR;
-    }
-    if (Tcl_DictObjGet(interp, dictPtr, keyPtr, &valuePtr1) != TCL_OK) {
-	return TCL_ERROR;
-    }
-    newValue1 = 0;
-    if (valuePtr1 == NULL) {
-	valuePtr1 = Tcl_NewDictObj();
-	newValue1 = 1;
-    }
-    keyPtr = ivPtr->namePtr;
-    if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
-	return TCL_ERROR;
-    }
-    if (valuePtr2 == NULL) {
-	valuePtr2 = Tcl_NewDictObj();
-    }
     if (AddDictEntry(interp, valuePtr2, "-name", ivPtr->namePtr) != TCL_OK) {
 	return TCL_ERROR;
     }
@@ -1231,67 +1118,45 @@ ItclAddClassVariableDictInfo(
 	    }
 	}
     }
-    keyPtr = ivPtr->namePtr;
-    if (Tcl_DictObjPut(interp, valuePtr1, keyPtr, valuePtr2) != TCL_OK) {
-	return TCL_ERROR;
-    }
-    if (newValue1) {
-	keyPtr = iclsPtr->fullNamePtr;
-	if (Tcl_DictObjPut(interp, dictPtr, keyPtr, valuePtr1) != TCL_OK) {
-	    return TCL_ERROR;
-	}
-    }
-    Tcl_SetVar2Ex(interp,
-	    ITCL_NAMESPACE"::internal::dicts::classVariables",
-	    NULL, dictPtr, TCL_GLOBAL_ONLY);
     return TCL_OK;
 }
 
 /*
  * ------------------------------------------------------------------------
  *  ItclAddClassFunctionDictInfo()
+ *
+ *  Marks a class function for ::itcl::internal::dicts::classFunctions.
+ *  The dict itself is only built when a script reads it; see
+ *  ItclTraceDictsVar().
  * ------------------------------------------------------------------------
  */
 int
 ItclAddClassFunctionDictInfo(
-    Tcl_Interp *interp,
-    ItclClass *iclsPtr,
+    TCL_UNUSED(Tcl_Interp *),
+    TCL_UNUSED(ItclClass *),
     ItclMemberFunc *imPtr)
 {
-    Tcl_Obj *dictPtr;
-    Tcl_Obj *keyPtr;
-    Tcl_Obj *valuePtr1;
-    Tcl_Obj *valuePtr2;
+    imPtr->flags |= ITCL_DICT_INFO;
+    return TCL_OK;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ClassFunctionDictInfo()
+ *
+ *  Fills "valuePtr2" with the classFunctions entry for "imPtr".
+ * ------------------------------------------------------------------------
+ */
+static int
+ClassFunctionDictInfo(
+    Tcl_Interp *interp,
+    ItclMemberFunc *imPtr,
+    Tcl_Obj *valuePtr2)
+{
     Tcl_Obj *listPtr;
     const char *cp;
     int haveFlags;
-    int newValue1;
 
-    dictPtr = Tcl_GetVar2Ex(interp,
-	     ITCL_NAMESPACE"::internal::dicts::classFunctions",
-	     NULL, TCL_GLOBAL_ONLY);
-    if (dictPtr == NULL) {
-	Tcl_AppendResult(interp, "cannot get dict ", ITCL_NAMESPACE,
-		"::internal::dicts::classFunctions", (char *)NULL);
-	return TCL_ERROR;
-    }
-    keyPtr = iclsPtr->fullNamePtr;
-    if (Tcl_DictObjGet(interp, dictPtr, keyPtr, &valuePtr1) != TCL_OK) {
-	return TCL_ERROR;
-    }
-    newValue1 = 0;
-    if (valuePtr1 == NULL) {
-	valuePtr1 = Tcl_NewDictObj();
-	newValue1 = 1;
-    }
-    keyPtr = imPtr->namePtr;
-    if (Tcl_DictObjGet(interp, valuePtr1, keyPtr, &valuePtr2) != TCL_OK) {
-	return TCL_ERROR;
-    }
-    if (valuePtr2 != NULL) {
-	Tcl_DictObjRemove(interp, valuePtr1, keyPtr);
-    }
-    valuePtr2 = Tcl_NewDictObj();
     if (AddDictEntry(interp, valuePtr2, "-name", imPtr->namePtr) != TCL_OK) {
 	return TCL_ERROR;
     }
@@ -1391,19 +1256,6 @@ ItclAddClassFunctionDictInfo(
 	    Tcl_DecrRefCount(listPtr);
 	}
     }
-    keyPtr = imPtr->namePtr;
-    if (Tcl_DictObjPut(interp, valuePtr1, keyPtr, valuePtr2) != TCL_OK) {
-	return TCL_ERROR;
-    }
-    if (newValue1) {
-	keyPtr = iclsPtr->fullNamePtr;
-	if (Tcl_DictObjPut(interp, dictPtr, keyPtr, valuePtr1) != TCL_OK) {
-	    return TCL_ERROR;
-	}
-    }
-    Tcl_SetVar2Ex(interp,
-	    ITCL_NAMESPACE"::internal::dicts::classFunctions",
-	    NULL, dictPtr, TCL_GLOBAL_ONLY);
     return TCL_OK;
 }
 
@@ -1507,3 +1359,169 @@ ItclAddClassDelegatedFunctionDictInfo(
 	    NULL, dictPtr, 0);
     return TCL_OK;
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclTraceDictsVar()
+ *
+ *  Invoked to handle read traces on the ::itcl::internal::dicts
+ *  variables describing objects, class variables and class functions.
+ *  Nothing in the core reads these, so rather than keeping them up to
+ *  date on every object creation and deletion, the dict is rebuilt
+ *  from the C structures whenever a script actually looks at it.
+ *  When the variable is unset, the trace is installed again, so that
+ *  the next read builds it anew.
+ * ------------------------------------------------------------------------
+ */
+
+#define ITCL_DICTS_OBJECTS		0
+#define ITCL_DICTS_CLASS_VARIABLES	1
+#define ITCL_DICTS_CLASS_FUNCTIONS	2
+
+static const char *dictsVarNames[] = {
+    ITCL_NAMESPACE"::internal::dicts::objects",
+    ITCL_NAMESPACE"::internal::dicts::classVariables",
+    ITCL_NAMESPACE"::internal::dicts::classFunctions",
+    NULL
+};
+
+static char *
+ItclTraceDictsVar(
+    void *cdata,	      /* which dict to build */
+    Tcl_Interp *interp,	      /* interpreter managing this variable */
+    TCL_UNUSED(const char *), /* variable name */
+    TCL_UNUSED(const char *), /* unused */
+    int flags)		      /* flags indicating read/write */
+{
+    FOREACH_HASH_DECLS;
+    ItclObjectInfo *infoPtr;
+    ItclObject *ioPtr;
+    ItclClass *iclsPtr;
+    ItclVariable *ivPtr;
+    ItclMemberFunc *imPtr;
+    Tcl_HashEntry *hPtr2;
+    Tcl_HashSearch search2;
+    Tcl_Obj *dictPtr;
+    Tcl_Obj *valuePtr1;
+    Tcl_Obj *valuePtr2;
+    int numObjects;
+    int code;
+
+    if (flags & TCL_INTERP_DESTROYED) {
+	return NULL;
+    }
+    if (flags & TCL_TRACE_UNSETS) {
+	if (flags & TCL_TRACE_DESTROYED) {
+	    Tcl_TraceVar2(interp, dictsVarNames[PTR2INT(cdata)], NULL,
+		    TCL_GLOBAL_ONLY|TCL_TRACE_READS|TCL_TRACE_UNSETS,
+		    ItclTraceDictsVar, cdata);
+	}
+	return NULL;
+    }
+    infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
+	    ITCL_INTERP_DATA, NULL);
+    if (infoPtr == NULL) {
+	return NULL;
+    }
+    code = TCL_OK;
+    dictPtr = Tcl_NewDictObj();
+    switch (PTR2INT(cdata)) {
+    case ITCL_DICTS_OBJECTS:
+	valuePtr1 = Tcl_NewDictObj();
+	numObjects = 0;
+	FOREACH_HASH_VALUE(ioPtr, &infoPtr->objects) {
+	    if (!(ioPtr->flags & ITCL_OBJECT_IS_CONSTRUCTED)
+		    || (ioPtr->accessCmd == NULL)) {
+		continue;
+	    }
+	    numObjects++;
+	    valuePtr2 = Tcl_NewDictObj();
+	    code = ObjectDictInfo(interp, ioPtr, valuePtr2);
+	    Tcl_DictObjPut(NULL, valuePtr1, ioPtr->namePtr, valuePtr2);
+	    if (code != TCL_OK) {
+		Tcl_DecrRefCount(valuePtr1);
+		goto dictError;
+	    }
+	}
+	if (numObjects > 0) {
+	    AddDictEntry(NULL, dictPtr, "instances", valuePtr1);
+	} else {
+	    Tcl_DecrRefCount(valuePtr1);
+	}
+	break;
+    case ITCL_DICTS_CLASS_VARIABLES:
+	FOREACH_HASH_VALUE(iclsPtr, &infoPtr->classes) {
+	    valuePtr1 = NULL;
+	    for (hPtr2 = Tcl_FirstHashEntry(&iclsPtr->variables, &search2);
+		    hPtr2 != NULL; hPtr2 = Tcl_NextHashEntry(&search2)) {
+		ivPtr = (ItclVariable *)Tcl_GetHashValue(hPtr2);
+		if (!(ivPtr->flags & ITCL_DICT_INFO)) {
+		    continue;
+		}
+		if (valuePtr1 == NULL) {
+		    valuePtr1 = Tcl_NewDictObj();
+		    Tcl_DictObjPut(NULL, dictPtr, iclsPtr->fullNamePtr,
+			    valuePtr1);
+		}
+		valuePtr2 = Tcl_NewDictObj();
+		code = ClassVariableDictInfo(interp, ivPtr, valuePtr2);
+		Tcl_DictObjPut(NULL, valuePtr1, ivPtr->namePtr, valuePtr2);
+		if (code != TCL_OK) {
+		    goto dictError;
+		}
+	    }
+	}
+	break;
+    default:
+	FOREACH_HASH_VALUE(iclsPtr, &infoPtr->classes) {
+	    valuePtr1 = NULL;
+	    for (hPtr2 = Tcl_FirstHashEntry(&iclsPtr->functions, &search2);
+		    hPtr2 != NULL; hPtr2 = Tcl_NextHashEntry(&search2)) {
+		imPtr = (ItclMemberFunc *)Tcl_GetHashValue(hPtr2);
+		if (!(imPtr->flags & ITCL_DICT_INFO)) {
+		    continue;
+		}
+		if (valuePtr1 == NULL) {
+		    valuePtr1 = Tcl_NewDictObj();
+		    Tcl_DictObjPut(NULL, dictPtr, iclsPtr->fullNamePtr,
+			    valuePtr1);
+		}
+		valuePtr2 = Tcl_NewDictObj();
+		code = ClassFunctionDictInfo(interp, imPtr, valuePtr2);
+		Tcl_DictObjPut(NULL, valuePtr1, imPtr->namePtr, valuePtr2);
+		if (code != TCL_OK) {
+		    goto dictError;
+		}
+	    }
+	}
+	break;
+    }
+    Tcl_SetVar2Ex(interp, dictsVarNames[PTR2INT(cdata)], NULL, dictPtr,
+	    TCL_GLOBAL_ONLY);
+    return NULL;
+
+dictError:
+    Tcl_DecrRefCount(dictPtr);
+    return (char *)"cannot build dict";
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclTraceDictsVars()
+ *
+ *  Installs the traces that build the lazily maintained
+ *  ::itcl::internal::dicts variables.  See ItclTraceDictsVar().
+ * ------------------------------------------------------------------------
+ */
+void
+ItclTraceDictsVars(
+    Tcl_Interp *interp)
+{
+    int i;
+
+    for (i = 0; dictsVarNames[i] != NULL; i++) {
+	Tcl_TraceVar2(interp, dictsVarNames[i], NULL,
+		TCL_GLOBAL_ONLY|TCL_TRACE_READS|TCL_TRACE_UNSETS,
+		ItclTraceDictsVar, INT2PTR(i));
+    }
+}
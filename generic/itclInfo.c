@@ -319,25 +319,12 @@ InfoGutsFinish(
     Tcl_CallFrame *framePtr = (Tcl_CallFrame *) data[0];
     ItclObjectInfo *infoPtr = (ItclObjectInfo *) data[1];
     ItclCallContext *cPtr = (ItclCallContext *) data[2];
-    ItclCallContext *popped;
-
-    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
-	    (char *) framePtr);
-
-    Itcl_Stack *stackPtr = (Itcl_Stack *) Tcl_GetHashValue(hPtr);
-
-    popped = (ItclCallContext *)Itcl_PopStack(stackPtr);
-
-    if (Itcl_GetStackSize(stackPtr) == 0) {
-	Itcl_DeleteStack(stackPtr);
-	Tcl_Free(stackPtr);
-	Tcl_DeleteHashEntry(hPtr);
-    }
+    ItclCallContext *popped = ItclPopCallRecord(infoPtr, framePtr, NULL);
 
     if (cPtr != popped) {
 	Tcl_Panic("Context stack mismatch!");
     }
-    Tcl_Free(cPtr);
+    ItclReleaseCallContext(infoPtr, cPtr);
 
     return result;
 }
@@ -353,9 +340,6 @@ ItclInfoGuts(
     Tcl_CmdInfo info;
     ItclCallContext *cPtr;
     Tcl_CallFrame *framePtr;
-    Tcl_HashEntry *hPtr;
-    Itcl_Stack *stackPtr;
-    int isNew;
 
     if (objc == 2) {
 	/*
@@ -372,23 +356,14 @@ ItclInfoGuts(
 
     framePtr = Itcl_GetUplevelCallFrame(interp, 0);
 
-    hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext, (char *)framePtr, &isNew);
-    if (isNew) {
-	stackPtr = (Itcl_Stack *)Tcl_Alloc(sizeof(Itcl_Stack));
-	Itcl_InitStack(stackPtr);
-	Tcl_SetHashValue(hPtr, stackPtr);
-    } else {
-	stackPtr = (Itcl_Stack *) Tcl_GetHashValue(hPtr);
-    }
-
-    cPtr = (ItclCallContext *)Tcl_Alloc(sizeof(ItclCallContext));
+    cPtr = ItclAllocCallContext(infoPtr);
     cPtr->objectFlags = ITCL_OBJECT_ROOT_METHOD;
     cPtr->nsPtr = NULL;
     cPtr->ioPtr = ioPtr;
     cPtr->imPtr = NULL;
     cPtr->refCount = 1;
 
-    Itcl_PushStack(cPtr, stackPtr);
+    ItclPushCallRecord(infoPtr, framePtr, NULL, cPtr);
 
     Tcl_NRAddCallback(interp, InfoGutsFinish, framePtr, infoPtr, cPtr, NULL);
     Tcl_GetCommandInfoFromToken(infoPtr->infoCmd, &info);
@@ -1539,20 +1514,16 @@ Itcl_BiInfoVariableCmd(
 			    }
 			}
 
-			objPtr = Tcl_NewStringObj((char*)NULL, 0);
-			Tcl_IncrRefCount(objPtr);
-			Tcl_AppendToObj(objPtr, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-			Tcl_AppendToObj(objPtr,
-				(Tcl_GetObjectNamespace(contextIoPtr->oPtr))->fullName, TCL_INDEX_NONE);
-
 			if (doAppend) {
-			    Tcl_AppendToObj(objPtr,
-				    Tcl_GetString(vlookup->ivPtr->fullNamePtr), TCL_INDEX_NONE);
+			    objPtr = ItclScopedVarName(interp,
+				    contextIoPtr, vlookup->ivPtr);
 			} else {
+			    objPtr = Tcl_DuplicateObj(contextIoPtr->varNsNamePtr);
 			    Tcl_AppendToObj(objPtr, "::", TCL_INDEX_NONE);
 			    Tcl_AppendToObj(objPtr,
 				    Tcl_GetString(vlookup->ivPtr->namePtr), TCL_INDEX_NONE);
 			}
+			Tcl_IncrRefCount(objPtr);
 		    }
 		    break;
 	    }
@@ -2151,7 +2122,7 @@ Itcl_BiInfoOptionCmd(
 	    return TCL_ERROR;
 	}
 	optionNamePtr = Tcl_NewStringObj(optionName, TCL_INDEX_NONE);
-	hPtr = Tcl_FindHashEntry(&contextIoPtr->objectOptions,
+	hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(contextIoPtr)->objectOptions,
 		(char *)optionNamePtr);
 	Tcl_DecrRefCount(optionNamePtr);
 	if (hPtr == NULL) {
@@ -3456,7 +3427,7 @@ Itcl_BiInfoOptionsCmd(
     if (ioPtr == NULL) {
 	tablePtr = &iclsPtr->options;
     } else {
-	tablePtr = &ioPtr->objectOptions;
+	tablePtr = &ITCL_OBJECT_EXT(ioPtr)->objectOptions;
     }
     FOREACH_HASH_VALUE(ioptPtr, tablePtr) {
 	name = Tcl_GetString(ioptPtr->namePtr);
@@ -3469,7 +3440,7 @@ Itcl_BiInfoOptionsCmd(
     if (ioPtr == NULL) {
 	tablePtr = &iclsPtr->delegatedOptions;
     } else {
-	tablePtr = &ioPtr->objectDelegatedOptions;
+	tablePtr = &ITCL_OBJECT_EXT(ioPtr)->objectDelegatedOptions;
     }
     FOREACH_HASH_VALUE(idoPtr, tablePtr) {
 	name = Tcl_GetString(idoPtr->namePtr);
@@ -4407,15 +4378,13 @@ Itcl_BiInfoWidgetadaptorCmd(
 
 static int
 Itcl_BiInfoInstancesCmd(
-    void *clientData,      /* ItclObjectInfo Ptr */
+    TCL_UNUSED(void *),    /* ItclObjectInfo Ptr */
     Tcl_Interp *interp,    /* current interpreter */
     int objc,	      /* number of arguments */
     Tcl_Obj *const objv[]) /* argument objects */
 {
-    FOREACH_HASH_DECLS;
     Tcl_Obj *listPtr;
     Tcl_Obj *objPtr;
-    ItclObjectInfo *infoPtr;
     ItclObject *ioPtr;
     ItclClass *iclsPtr;
     const char *pattern;
@@ -4438,24 +4407,22 @@ Itcl_BiInfoInstancesCmd(
     if (objc == 2) {
 	pattern = Tcl_GetString(objv[1]);
     }
-    infoPtr = (ItclObjectInfo *)clientData;
     listPtr = Tcl_NewListObj(0, NULL);
-    FOREACH_HASH_VALUE(ioPtr, &infoPtr->objects) {
-	/* FIXME need to scan the inheritance too */
-	if (ioPtr->iclsPtr == iclsPtr) {
-	    if (ioPtr->iclsPtr->flags & ITCL_WIDGETADAPTOR) {
-		objPtr = Tcl_NewStringObj(Tcl_GetCommandName(interp,
-		ioPtr->accessCmd), TCL_INDEX_NONE);
-	    } else {
-		objPtr = Tcl_NewObj();
-		Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
-	    }
-	    if ((pattern == NULL) ||
+    /* FIXME need to scan the inheritance too */
+    for (ioPtr = iclsPtr->firstInstancePtr; ioPtr != NULL;
+	    ioPtr = ioPtr->nextInstancePtr) {
+	if (ioPtr->iclsPtr->flags & ITCL_WIDGETADAPTOR) {
+	    objPtr = Tcl_NewStringObj(Tcl_GetCommandName(interp,
+		    ioPtr->accessCmd), TCL_INDEX_NONE);
+	} else {
+	    objPtr = Tcl_NewObj();
+	    Tcl_GetCommandFullName(interp, ioPtr->accessCmd, objPtr);
+	}
+	if ((pattern == NULL) ||
 		Tcl_StringCaseMatch(Tcl_GetString(objPtr), pattern, 0)) {
-		Tcl_ListObjAppendElement(interp, listPtr, objPtr);
-	    } else {
-		Tcl_DecrRefCount(objPtr);
-	    }
+	    Tcl_ListObjAppendElement(interp, listPtr, objPtr);
+	} else {
+	    Tcl_DecrRefCount(objPtr);
 	}
     }
     Tcl_SetObjResult(interp, listPtr);
@@ -4816,7 +4783,7 @@ Itcl_BiInfoDelegatedOptionCmd(
 	    return TCL_ERROR;
 	}
 	optionNamePtr = Tcl_NewStringObj(optionName, TCL_INDEX_NONE);
-	hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedOptions,
+	hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(contextIoPtr)->objectDelegatedOptions,
 		(char *)optionNamePtr);
 	Tcl_DecrRefCount(optionNamePtr);
 	if (hPtr == NULL) {
@@ -5036,7 +5003,7 @@ Itcl_BiInfoDelegatedMethodCmd(
     if (cmdName) {
 	cmdNamePtr = Tcl_NewStringObj(cmdName, TCL_INDEX_NONE);
 	if (contextIoPtr != NULL) {
-	    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedFunctions,
+	    hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(contextIoPtr)->objectDelegatedFunctions,
 		    (char *)cmdNamePtr);
 	} else {
 	    hPtr = Tcl_FindHashEntry(&contextIclsPtr->delegatedFunctions,
@@ -5261,7 +5228,7 @@ Itcl_BiInfoDelegatedTypeMethodCmd(
     if (cmdName) {
 	cmdNamePtr = Tcl_NewStringObj(cmdName, TCL_INDEX_NONE);
 	if (contextIoPtr != NULL) {
-	    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectDelegatedFunctions,
+	    hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(contextIoPtr)->objectDelegatedFunctions,
 		    (char *)cmdNamePtr);
 	} else {
 	    hPtr = Tcl_FindHashEntry(&contextIclsPtr->delegatedFunctions,
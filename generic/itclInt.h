@@ -177,7 +177,8 @@ typedef struct ItclObjectInfo {
     Tcl_HashTable procMethods;      /* maps from procPtr to mFunc */
     Tcl_HashTable instances;        /* maps from instanceNumber to ioPtr */
     Tcl_HashTable unused8;          /* maps from ioPtr to instanceNumber */
-    Tcl_HashTable frameContext;     /* maps frame to context stack */
+    Tcl_HashTable frameContext;     /* maps frame to its innermost indexed
+				     * ItclCallRecord, see callRecords */
     Tcl_HashTable classTypes;       /* maps from class type i.e. "widget"
 				     * to define value i.e. ITCL_WIDGET */
     int protection;                 /* protection level currently in effect */
@@ -232,6 +233,32 @@ typedef struct ItclObjectInfo {
     Tcl_Obj *typeDestructorArgumentPtr;
     struct ItclObject *lastIoPtr;   /* last object constructed */
     Tcl_Command infoCmd;
+    Tcl_Size varSlotsEpoch;         /* last id handed out to a class variable
+				     * slot layout, see ItclInitVarSlots */
+    Tcl_HashTable contextCallRecords;
+				    /* maps TclOO context to its innermost
+				     * indexed ItclCallRecord */
+    struct ItclCallRecord *freeCallRecords;
+				    /* call records kept for reuse */
+    struct ItclCallContext *freeCallContexts;
+				    /* call contexts kept for reuse, see
+				     * ItclAllocCallContext */
+    Tcl_Size methodCacheEpoch;      /* bumped by Itcl_BuildVirtualTables,
+				     * invalidates all ItclMethodCacheEntry */
+    int flatVariables;              /* whether objects of plain classes keep
+				     * all their variables in one namespace,
+				     * see ITCL_FLAT_VARIABLES */
+    struct ItclObjectExt *emptyObjectExt;
+				    /* empty tables standing in for the
+				     * ItclObjectExt of objects that have
+				     * none, see ITCL_OBJECT_EXT */
+    Tcl_Size accessEpoch;           /* bumped whenever a class namespace
+				     * comes or goes or an inheritance
+				     * changes, invalidates the access
+				     * caches of classes and methods */
+    struct ItclCallRecord *callRecords;
+				    /* innermost record of the active calls
+				     * of the interp, see ItclCallRecord */
 } ItclObjectInfo;
 
 typedef struct EnsembleInfo {
@@ -240,6 +267,21 @@ typedef struct EnsembleInfo {
     Tcl_Size numEnsembles;
     Tcl_Namespace *ensembleNsPtr;
 } EnsembleInfo;
+/*
+ *  Cached result of mapping an unqualified method name called from a
+ *  given namespace, see ItclMapMethodNameProc.
+ */
+#define ITCL_METHOD_CACHE_SLOTS 4
+
+typedef struct ItclMethodCacheEntry {
+    Tcl_Obj *namePtr;             /* the method name or NULL if unused */
+    Tcl_Namespace *nsPtr;         /* namespace the call came from */
+    Tcl_Size epoch;               /* methodCacheEpoch when filled in */
+    struct ItclCmdLookup *clookupPtr;
+				  /* the public method found or NULL if the
+				   * class has no such method */
+} ItclMethodCacheEntry;
+
 /*
  *  Representation for each [incr Tcl] class.
  */
@@ -264,7 +306,12 @@ typedef struct EnsembleInfo {
 #define ITCL_CLASS_NS_TEARDOWN            0x40000
 #define ITCL_CLASS_NO_VARNS_DELETE        0x80000
 #define ITCL_CLASS_SHOULD_VARNS_DELETE   0x100000
+#define ITCL_CLASS_FLAT_VARIABLES        0x200000
 #define ITCL_CLASS_DESTRUCTOR_CALLED     0x400000
+#define ITCL_CLASS_LIFECYCLE_PLAN        0x800000
+#define ITCL_CLASS_OPTION_SLOTS         0x1000000
+#define ITCL_CLASS_OPTION_DISPATCH      0x2000000
+#define ITCL_CLASS_PUBLIC_OPTS          0x4000000
 
 
 typedef struct ItclClass {
@@ -339,11 +386,108 @@ typedef struct ItclClass {
     Tcl_Obj *typeConstructorPtr;  /* initialization for types */
     int destructorHasBeenCalled;  /* prevent multiple invocations of destrcutor */
     Tcl_Size refCount;
+    Tcl_HashTable resolveCmdNames; /* string keyed view of resolveCmds, so
+				   * the command resolver can probe without
+				   * creating a Tcl_Obj.  The ItclCmdLookup
+				   * values are owned by resolveCmds */
+    Tcl_HashTable varSlotTable;   /* maps the ItclVariable* of every instance
+				   * variable in the hierarchy to its index
+				   * in the varSlots array of the objects */
+    Tcl_Size numVarSlots;         /* number of entries in varSlotTable */
+    Tcl_Size varSlotsId;          /* unique id of this slot layout or 0 if
+				   * varSlotTable has not been built yet */
+    ItclMethodCacheEntry methodCache[ITCL_METHOD_CACHE_SLOTS];
+				  /* methods last called on objects of
+				   * this class */
+    int nextMethodCacheSlot;      /* entry to replace next */
+    struct ItclObject *firstInstancePtr;
+				  /* live objects whose most specific class
+				   * this is, in order of creation, linked
+				   * through their nextInstancePtr */
+    struct ItclObject *lastInstancePtr;
+    Tcl_Size numInstances;        /* number of objects in that list */
+    struct ItclInitStep *initPlan;/* steps replayed to set up the variables
+				   * of each new object, or NULL if not
+				   * built yet, see ItclInitObjectVariables */
+    Tcl_Size numInitSteps;        /* number of entries in initPlan */
+    Tcl_Size numConstructors;     /* classes in the hierarchy that have a
+				   * constructor or initCode, valid with
+				   * ITCL_CLASS_LIFECYCLE_PLAN */
+    struct ItclClass **destructPlan;
+				  /* classes in the hierarchy that have a
+				   * destructor, most-specific first, see
+				   * ItclBuildLifecyclePlan */
+    Tcl_Size numDestructors;      /* number of entries in destructPlan */
+    Tcl_HashTable optionSlotTable;/* maps the ItclOption* of every option
+				   * of an object of this class to its index
+				   * in the optionSlots of the object, valid
+				   * with ITCL_CLASS_OPTION_SLOTS */
+    Tcl_Size numOptionSlots;      /* number of entries in optionSlotTable */
+    Tcl_HashTable optionDispatch; /* maps option names to the
+				   * ItclOptionDispatch entries used by
+				   * configure and cget, valid with
+				   * ITCL_CLASS_OPTION_DISPATCH */
+    struct ItclDelegatedOption *allOptionsPtr;
+				  /* "delegate option *" of the hierarchy or
+				   * NULL */
+    struct ItclDelegatedFunction *configureIdmPtr;
+				  /* "delegate method *" of this class if it
+				   * covers "configure", or NULL */
+    struct ItclDelegatedFunction *cgetIdmPtr;
+				  /* same for "cget" */
+    struct ItclPublicOpt *publicOpts;
+				  /* public variables of the hierarchy in
+				   * the order "configure" reports them,
+				   * valid with ITCL_CLASS_PUBLIC_OPTS */
+    Tcl_Size numPublicOpts;       /* number of entries in publicOpts */
+    Tcl_HashTable delegateMethods;/* ItclDelegatedFunction* of the delegated
+				   * methods installed in clsPtr */
+    Tcl_HashTable componentDelegations;
+				  /* maps an ItclComponent* to the Itcl_List
+				   * of delegated methods going to it, see
+				   * ItclComponentDelegations() */
+    Tcl_Size numComponentDelegations;
+				  /* size of delegatedFunctions when
+				   * componentDelegations was built */
+    struct ItclClass **mro;       /* the class and its base classes from
+				   * most-to-least specific, or NULL until
+				   * first walked, see ItclResetMro() */
+    Tcl_Size numMro;              /* number of classes in mro */
+    struct ItclClass **isaDisplay;
+				  /* the chain of first base classes, root
+				   * first: isaDisplay[d] is the ancestor at
+				   * depth d, isaDisplay[isaDepth] the class
+				   * itself.  NULL until needed, see
+				   * ItclClassIsa() */
+    Tcl_Size isaDepth;            /* number of first base classes above */
+    struct ItclClass **isaOthers; /* ancestors not in isaDisplay, sorted by
+				   * address, or NULL if there are none */
+    Tcl_Size numIsaOthers;        /* number of classes in isaOthers */
+    Tcl_Namespace *accessNsPtr;   /* namespace of the last protected or
+				   * private access check, see
+				   * Itcl_CanAccess2() */
+    Tcl_Size accessEpoch;         /* infoPtr->accessEpoch when accessNsPtr
+				   * was checked */
+    int accessFlags;              /* ITCL_ACCESS_* granted to accessNsPtr */
+    struct ItclVariable **slotVars;
+				  /* the variable of each slot of
+				   * varSlotTable, in slot order */
 } ItclClass;
 
+/*
+ *  Access granted to ItclClass accessNsPtr.
+ */
+#define ITCL_ACCESS_PRIVATE              0x01
+#define ITCL_ACCESS_PROTECTED            0x02
+
+/*
+ *  The layout is kept for the stubs interface, but the stack is no
+ *  longer used as one: its values hold a copy of the mro of the class,
+ *  len is the position of the next class and max the size.
+ */
 typedef struct ItclHierIter {
     ItclClass *current;           /* current position in hierarchy */
-    Itcl_Stack stack;             /* stack used for traversal */
+    Itcl_Stack stack;             /* copy of the mro of the class */
 } ItclHierIter;
 
 #define ITCL_OBJECT_IS_DELETED           0x01
@@ -354,21 +498,24 @@ typedef struct ItclHierIter {
 #define ITCL_TCLOO_OBJECT_IS_DELETED     0x20
 #define ITCL_OBJECT_DESTRUCT_ERROR       0x40
 #define ITCL_OBJECT_SHOULD_VARNS_DELETE  0x80
+#define ITCL_OBJECT_UPDATING_BUILTINS    0x100
+#define ITCL_OBJECT_CLASS_OPTIONS        0x200
+#define ITCL_OBJECT_OWN_OPTIONS          0x400
+#define ITCL_OBJECT_IS_CONSTRUCTED       0x800
 #define ITCL_OBJECT_ROOT_METHOD          0x8000
 
 /*
- *  Representation for each [incr Tcl] object.
+ *  Number of method call contexts cached inline in each object.
  */
-typedef struct ItclObject {
-    ItclClass *iclsPtr;          /* most-specific class */
-    Tcl_Command accessCmd;       /* object access command */
+#define ITCL_CONTEXT_SLOTS 4
 
-    Tcl_HashTable *constructed;  /* temp storage used during construction */
-    Tcl_HashTable *destructed;   /* temp storage used during destruction */
-    Tcl_HashTable objectVariables;
-				 /* used for storing Tcl_Var entries for
-				  * variable resolving, key is ivPtr of
-				  * variable, value is varPtr */
+/*
+ *  Tables of an object that only extended classes, types and widgets
+ *  fill.  They are allocated on first use by ItclGetObjectExt(); until
+ *  then ITCL_OBJECT_EXT() yields an empty set shared by the interpreter
+ *  so that lookups need no special casing.
+ */
+typedef struct ItclObjectExt {
     Tcl_HashTable objectOptions; /* definitions for all option members
 				     in this object. Look up option namePtr
 				     names and get back ItclOption* ptrs */
@@ -390,7 +537,38 @@ typedef struct ItclObject {
 				     members in this object. Look up function
 				     namePtr names and get back
 				     ItclMemberFunc * ptrs */
-    Tcl_HashTable contextCache;   /* cache for function contexts */
+    Tcl_Var *optionSlots;	  /* preserved "itcl_options" elements indexed
+				   * by the optionSlotTable of the class, or
+				   * NULL entries until first used */
+    Tcl_Size numOptionSlots;      /* size of the optionSlots array */
+    Tcl_HashTable delegationPlans;/* maps the ItclDelegatedFunction* of a
+				   * delegated method to the command prefix
+				   * its calls are forwarded to, see
+				   * ItclDelegationPrefix() */
+    Tcl_HashTable componentValues;/* maps an ItclComponent* to the value its
+				   * variable had at the last write */
+} ItclObjectExt;
+
+#define ITCL_OBJECT_EXT(ioPtr) \
+    ((ioPtr)->extPtr != NULL ? (ioPtr)->extPtr \
+	    : (ioPtr)->infoPtr->emptyObjectExt)
+
+/*
+ *  Representation for each [incr Tcl] object.
+ */
+typedef struct ItclObject {
+    ItclClass *iclsPtr;          /* most-specific class */
+    Tcl_Command accessCmd;       /* object access command */
+
+    Tcl_HashTable *constructed;  /* temp storage used during construction,
+				  * NULL if the hierarchy has no constructors */
+    Tcl_HashTable objectVariables;
+				 /* used for storing Tcl_Var entries for
+				  * variable resolving, key is ivPtr of
+				  * variable, value is varPtr */
+    struct ItclObjectExt *extPtr; /* option, component, methodvariable and
+				   * delegation tables or NULL if none were
+				   * needed yet, see ITCL_OBJECT_EXT */
     Tcl_Obj *namePtr;
     Tcl_Obj *origNamePtr;         /* the original name before any rename */
     Tcl_Obj *createNamePtr;       /* the temp name before any rename
@@ -411,6 +589,31 @@ typedef struct ItclObject {
     int noComponentTrace;         /* don't call component traces if
 				   * setting components in DelegationInstall */
     int hadConstructorError;      /* needed for multiple calls of CallItclObjectCmd */
+    Tcl_Var thisVarPtr;           /* the "this" variable of the most specific
+				   * class, shared with objectVariables */
+    Tcl_Var optionsVarPtr;        /* preserved "itcl_options" variable of the
+				   * object or NULL if not looked up yet */
+    Tcl_Var optionComponentsVarPtr;
+				  /* preserved "itcl_option_components"
+				   * variable or NULL if not looked up yet */
+    Tcl_Var *varSlots;            /* instance variables indexed by the slot
+				   * numbers of the class varSlotTable.  The
+				   * variables are owned by objectVariables */
+    Tcl_Size numVarSlots;         /* size of the varSlots array */
+    struct ItclCallContext *contextSlots[ITCL_CONTEXT_SLOTS];
+				  /* call contexts of the methods called
+				   * last, reused while not busy */
+    int nextContextSlot;          /* slot to replace next when all slots
+				   * are taken */
+    struct ItclObject *prevInstancePtr;
+    struct ItclObject *nextInstancePtr;
+				  /* neighbours in the instance list of
+				   * iclsPtr, see firstInstancePtr */
+    Tcl_Obj *configReportPtr;     /* result of the last "configure" without
+				   * arguments or NULL, reused as long as
+				   * the public variables keep their values */
+    Tcl_Size varSlotsId;          /* varSlotsId of the class layout the
+				   * varSlots array follows */
 } ItclObject;
 
 #define ITCL_IGNORE_ERRS  0x002  /* useful for construction/destruction */
@@ -459,6 +662,8 @@ typedef struct ItclMemberCode {
  */
 #define ITCL_COMMON            0x010  /* non-zero => is a "proc" or common
 				       * variable */
+#define ITCL_DICT_INFO         0x80000 /* non-zero => reported in the
+				       * ::itcl::internal::dicts tables */
 
 /*
  *  Flag bits for ItclMember: functions
@@ -471,6 +676,9 @@ typedef struct ItclMemberCode {
 #define ITCL_COMPONENT         0x800  /* non-zero => component */
 #define ITCL_TYPE_METHOD       0x1000 /* non-zero => typemethod */
 #define ITCL_METHOD            0x2000 /* non-zero => method */
+#define ITCL_ANY_CONTEXT       0x4000 /* non-zero => may be called by its
+				       * simple name from methods and
+				       * typemethods of types/widgets */
 
 /*
  *  Flag bits for ItclMember: variables
@@ -541,6 +749,11 @@ typedef struct ItclMemberFunc {
     void *tmPtr;                /* TclOO methodPtr */
     ItclDelegatedFunction *idmPtr;
 				/* if the function is delegated != NULL */
+    Tcl_Namespace *accessNsPtr; /* namespace of the last access check, see
+				 * Itcl_CanAccessFunc() */
+    Tcl_Size accessEpoch;       /* infoPtr->accessEpoch when accessNsPtr
+				 * was checked */
+    int accessOk;               /* whether accessNsPtr has access */
 } ItclMemberFunc;
 
 /*
@@ -559,8 +772,48 @@ typedef struct ItclVariable {
     int initted;                /* is set when first time initted, to check
 				 * for example itcl_hull var, which can be only
 				 * initialized once */
+    Tcl_Obj *flatNamePtr;       /* name of the variable in the variables
+				 * namespace of objects of classes with
+				 * ITCL_CLASS_FLAT_VARIABLES, or NULL */
+    Tcl_Size slotIndex;         /* slot of the variable in the layout of
+				 * iclsPtr, which is also its slot in every
+				 * class derived from iclsPtr through first
+				 * base classes, see ItclInitVarSlots() */
 } ItclVariable;
 
+/*
+ *  Object initialization plan.  When the first object of a class is
+ *  created, the work needed to set up the variables of an instance is
+ *  compiled into an array of these steps, which is then replayed for
+ *  every object of the class.
+ */
+typedef struct ItclInitStep {
+    int op;                     /* what to do, see ITCL_INIT_* below */
+    ItclClass *iclsPtr;         /* ITCL_INIT_NAMESPACE: class whose variable
+				 * namespace is set up next, or NULL for
+				 * the variables namespace of the object */
+    ItclVariable *ivPtr;        /* variable the step applies to */
+    Tcl_Size slotIndex;         /* ITCL_INIT_VARIABLE: index into the
+				 * varSlots of the object or -1 */
+    Tcl_Var varPtr;             /* ITCL_INIT_COMMON: the common variable */
+    ItclComponent *icPtr;       /* ITCL_INIT_COMPONENT: the component */
+    Tcl_Obj *namePtr;           /* name of the variable in the current
+				 * namespace, or its full name for some
+				 * traces */
+    int traceFlags;             /* ITCL_INIT_TRACE: TCL_TRACE_* flags */
+    Tcl_VarTraceProc *traceProc;/* ITCL_INIT_TRACE: trace procedure */
+} ItclInitStep;
+
+#define ITCL_INIT_NAMESPACE     1  /* create the variable namespace of a
+				    * class and make it current */
+#define ITCL_INIT_COMPONENT     2  /* register a component of the object */
+#define ITCL_INIT_VARIABLE      3  /* create an instance variable */
+#define ITCL_INIT_THIS          4  /* remember it as the "this" variable */
+#define ITCL_INIT_COMMON        5  /* link a common into the object */
+#define ITCL_INIT_BUILTIN       6  /* set a built-in variable like "this" */
+#define ITCL_INIT_VALUE         7  /* set the initial value */
+#define ITCL_INIT_TRACE         8  /* attach a variable trace */
+
 
 struct ItclOption;
 
@@ -600,6 +853,19 @@ typedef struct ItclOption {
 				/* if the option is delegated != NULL */
 } ItclOption;
 
+/*
+ *  What an option name stands for in objects of a class: the entries
+ *  of their objectOptions and objectDelegatedOptions tables combined,
+ *  see ItclBuildOptionDispatch().
+ */
+typedef struct ItclOptionDispatch {
+    ItclOption *ioptPtr;        /* option of that name or NULL */
+    ItclDelegatedOption *idoPtr;
+				/* delegated option of that name or NULL */
+    Tcl_Size slotIndex;         /* index of ioptPtr in the optionSlots of
+				 * the objects or -1 */
+} ItclOptionDispatch;
+
 /*
  *  Instance methodvariables.
  */
@@ -643,8 +909,36 @@ typedef struct ItclVarLookup {
 			       * it shouldn't be freed. */
     Tcl_Size varNum;
     Tcl_Var varPtr;
+    int specialKind;          /* ITCL_VAR_KIND_* for built-in variables
+			       * bound directly to handles cached in the
+			       * ItclObject */
+    Tcl_Size slotIndex;       /* slot of ivPtr in the layout of its class
+			       * or -1, see ItclVariable */
+    Tcl_Size otherSlotsId;    /* varSlotsId of the class otherSlotIndex
+			       * below was looked up for, 0 if none */
+    Tcl_Size otherSlotIndex;  /* slot of ivPtr in a class that inherits
+			       * it through a base class other than the
+			       * first one */
 } ItclVarLookup;
 
+/*
+ *  Public variable reported by the "configure" method.
+ */
+typedef struct ItclPublicOpt {
+    ItclVarLookup *vlookup;   /* lookup record of the variable in the
+			       * class owning the publicOpts array */
+    Tcl_Obj *optionNamePtr;   /* "-" followed by the least qualified name */
+    Tcl_Obj *initPtr;         /* initial value or "<undefined>" */
+} ItclPublicOpt;
+
+/*
+ *  Values for ItclVarLookup.specialKind
+ */
+#define ITCL_VAR_KIND_NORMAL            0
+#define ITCL_VAR_KIND_THIS              1
+#define ITCL_VAR_KIND_OPTIONS           2
+#define ITCL_VAR_KIND_OPTION_COMPONENTS 3
+
 /*
  *  Instance command lookup entry.
  */
@@ -663,8 +957,44 @@ typedef struct ItclCallContext {
     ItclObject *ioPtr;
     ItclMemberFunc *imPtr;
     Tcl_Size refCount;
+    int isCached;                 /* set if owned by the contextSlots of
+				   * ioPtr rather than by the call */
+    struct ItclCallContext *nextPtr;
+				  /* next free context in the pool */
 } ItclCallContext;
 
+/*
+ *  One record per active method call (or explicitly set context).  The
+ *  records of an interp form a stack in the order the calls were made.
+ *  Calls normally finish innermost first and look for the innermost
+ *  record, so these operations only touch the top of the stack.
+ *  Coroutines may finish calls out of order or look for a record below
+ *  the top.  Only then the records are entered into the frameContext and
+ *  contextCallRecords tables of the interp, which hold the innermost
+ *  indexed record of each frame and TclOO context; outer records of the
+ *  same key are chained behind it.
+ */
+typedef struct ItclCallRecord {
+    Tcl_CallFrame *framePtr;      /* frame the context belongs to */
+    Tcl_ObjectContext contextPtr; /* TclOO context of the call or NULL */
+    ItclCallContext *callContextPtr;
+    struct ItclCallRecord *outerPtr;
+				  /* next record below on the stack, or
+				   * next free record */
+    struct ItclCallRecord *innerPtr;
+				  /* next record above on the stack */
+    Tcl_HashEntry *frameEntry;    /* entry of framePtr in frameContext or
+				   * NULL if not indexed */
+    Tcl_HashEntry *contextEntry;  /* entry of contextPtr in
+				   * contextCallRecords or NULL */
+    struct ItclCallRecord *nextFramePtr;
+				  /* next outer indexed record of the same
+				   * frame */
+    struct ItclCallRecord *nextContextPtr;
+				  /* next outer indexed record of the same
+				   * context */
+} ItclCallRecord;
+
 /*
  * The macro below is used to modify a "char" value (e.g. by casting
  * it to an unsigned character) so that it can be used safely with
@@ -734,6 +1064,49 @@ MODULE_SCOPE int ItclInfoInit(Tcl_Interp *interp, ItclObjectInfo *infoPtr);
 
 MODULE_SCOPE Tcl_HashEntry *ItclResolveVarEntry(
 	ItclClass* iclsPtr, const char *varName);
+MODULE_SCOPE int ItclVarSpecialKind(ItclVariable *ivPtr);
+MODULE_SCOPE void ItclPushCallRecord(ItclObjectInfo *infoPtr,
+	Tcl_CallFrame *framePtr, Tcl_ObjectContext contextPtr,
+	ItclCallContext *callContextPtr);
+MODULE_SCOPE ItclCallContext *ItclPopCallRecord(ItclObjectInfo *infoPtr,
+	Tcl_CallFrame *framePtr, Tcl_ObjectContext contextPtr);
+MODULE_SCOPE ItclCallContext *ItclPeekCallRecord(ItclObjectInfo *infoPtr,
+	Tcl_CallFrame *framePtr);
+MODULE_SCOPE void ItclFreeCallRecords(ItclObjectInfo *infoPtr);
+MODULE_SCOPE ItclCallContext *ItclAllocCallContext(ItclObjectInfo *infoPtr);
+MODULE_SCOPE void ItclReleaseCallContext(ItclObjectInfo *infoPtr,
+	ItclCallContext *contextPtr);
+MODULE_SCOPE void ItclInitVarSlots(ItclClass *iclsPtr);
+MODULE_SCOPE Tcl_Size ItclVarSlotIndex(ItclVariable *ivPtr);
+MODULE_SCOPE void ItclBuildPublicOpts(ItclClass *iclsPtr);
+MODULE_SCOPE void ItclFreePublicOpts(ItclClass *iclsPtr);
+MODULE_SCOPE Itcl_List *ItclComponentDelegations(ItclClass *iclsPtr,
+	ItclComponent *icPtr);
+MODULE_SCOPE void ItclFreeComponentDelegations(ItclClass *iclsPtr);
+MODULE_SCOPE void ItclResetMro(ItclClass *iclsPtr);
+MODULE_SCOPE int ItclClassIsa(ItclClass *iclsPtr, ItclClass *basePtr);
+MODULE_SCOPE void ItclFreeInitPlan(ItclClass *iclsPtr);
+MODULE_SCOPE void ItclBuildLifecyclePlan(ItclClass *iclsPtr);
+MODULE_SCOPE void ItclFreeLifecyclePlan(ItclClass *iclsPtr);
+MODULE_SCOPE void ItclResetObjectPlans(ItclClass *iclsPtr);
+MODULE_SCOPE Tcl_Obj *ItclInstanceVarName(ItclObject *ioPtr,
+	ItclVariable *ivPtr);
+MODULE_SCOPE Tcl_Obj *ItclScopedVarName(Tcl_Interp *interp,
+	ItclObject *ioPtr, ItclVariable *ivPtr);
+MODULE_SCOPE ItclObjectExt *ItclNewObjectExt(void);
+MODULE_SCOPE void ItclFreeObjectExt(ItclObjectExt *extPtr);
+MODULE_SCOPE ItclObjectExt *ItclGetObjectExt(ItclObject *ioPtr);
+MODULE_SCOPE Tcl_Obj *ItclGetOptionValue(Tcl_Interp *interp,
+	ItclObject *ioPtr, ItclOption *ioptPtr, Tcl_Size slotIndex);
+MODULE_SCOPE int ItclSetOptionValue(Tcl_Interp *interp, ItclObject *ioPtr,
+	ItclOption *ioptPtr, Tcl_Size slotIndex, Tcl_Obj *valuePtr);
+MODULE_SCOPE void ItclBuildOptionDispatch(ItclClass *iclsPtr);
+MODULE_SCOPE void ItclFreeOptionDispatch(ItclClass *iclsPtr);
+MODULE_SCOPE Tcl_Var ItclObjectSpecialVar(Tcl_Interp *interp,
+	ItclObject *ioPtr, int specialKind);
+MODULE_SCOPE void ItclFreeMethodCache(ItclClass *iclsPtr);
+MODULE_SCOPE Tcl_Var ItclGetObjectVarSlot(ItclObject *ioPtr,
+	ItclVarLookup *vlookup);
 
 struct Tcl_ResolvedVarInfo;
 MODULE_SCOPE int Itcl_ClassCmdResolver(Tcl_Interp *interp, const char* name,
@@ -808,9 +1181,7 @@ MODULE_SCOPE int Itcl_EnsembleDeleteCmd(void *clientData,
 MODULE_SCOPE int ItclAddClassesDictInfo(Tcl_Interp *interp, ItclClass *iclsPtr);
 MODULE_SCOPE int ItclDeleteClassesDictInfo(Tcl_Interp *interp,
 	ItclClass *iclsPtr);
-MODULE_SCOPE int ItclAddObjectsDictInfo(Tcl_Interp *interp, ItclObject *ioPtr);
-MODULE_SCOPE int ItclDeleteObjectsDictInfo(Tcl_Interp *interp,
-	ItclObject *ioPtr);
+MODULE_SCOPE void ItclTraceDictsVars(Tcl_Interp *interp);
 MODULE_SCOPE int ItclAddOptionDictInfo(Tcl_Interp *interp, ItclClass *iclsPtr,
 	ItclOption *ioptPtr);
 MODULE_SCOPE int ItclAddDelegatedOptionDictInfo(Tcl_Interp *interp,
@@ -439,6 +439,17 @@ Itcl_CreateProc(
 }
 
 
+/*
+ * Names of the members which Itcl_ClassCmdResolver() lets through from
+ * any context of a ::itcl::type, ::itcl::widget or ::itcl::widgetadaptor,
+ * as long as they are called by exactly that name.
+ */
+static const char *anyContextNames[] = {
+    "info", "mytypemethod", "myproc", "mymethod", "mytypevar", "myvar",
+    "itcl_hull", "callinstance", "getinstancevar", "installcomponent",
+    NULL
+};
+
 /*
  * ------------------------------------------------------------------------
  *  ItclCreateMemberFunc()
@@ -465,6 +476,7 @@ ItclCreateMemberFunc(
     int flags)
 {
     int newEntry;
+    int i;
     char *name;
     ItclMemberFunc *imPtr;
     ItclMemberCode *mcode;
@@ -633,6 +645,12 @@ ItclCreateMemberFunc(
 	    imPtr->flags |= ITCL_COMMON;
 	}
     }
+    for (i = 0; anyContextNames[i] != NULL; i++) {
+	if (strcmp(name, anyContextNames[i]) == 0) {
+	    imPtr->flags |= ITCL_ANY_CONTEXT;
+	    break;
+	}
+    }
     if (strcmp(name, "constructor") == 0) {
 	/*
 	 * REVISE mcode->bodyPtr here!
@@ -655,6 +673,10 @@ ItclCreateMemberFunc(
     if (strcmp(name, "destructor") == 0) {
 	imPtr->flags |= ITCL_DESTRUCTOR;
     }
+    if (imPtr->flags & (ITCL_CONSTRUCTOR|ITCL_DESTRUCTOR)) {
+	/* objects created from now on have to call it */
+	ItclResetObjectPlans(iclsPtr);
+    }
 
     Tcl_SetHashValue(hPtr, imPtr);
     Itcl_PreserveData(imPtr);
@@ -1415,29 +1437,19 @@ Itcl_SetContext(
     Tcl_Interp *interp,
     ItclObject *ioPtr)
 {
-    int isNew;
-    Itcl_Stack *stackPtr;
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
     ItclObjectInfo *infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
 	    ITCL_INTERP_DATA, NULL);
-    Tcl_HashEntry *hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr, &isNew);
-    ItclCallContext *contextPtr
-	    = (ItclCallContext *)Tcl_Alloc(sizeof(ItclCallContext));
+    ItclCallContext *contextPtr = ItclAllocCallContext(infoPtr);
 
     memset(contextPtr, 0, sizeof(ItclCallContext));
     contextPtr->ioPtr = ioPtr;
     contextPtr->refCount = 1;
 
-    if (!isNew) {
+    if (ItclPeekCallRecord(infoPtr, framePtr) != NULL) {
 	Tcl_Panic("frame already has context?!");
     }
-
-    stackPtr = (Itcl_Stack *)Tcl_Alloc(sizeof(Itcl_Stack));
-    Itcl_InitStack(stackPtr);
-    Tcl_SetHashValue(hPtr, stackPtr);
-
-    Itcl_PushStack(contextPtr, stackPtr);
+    ItclPushCallRecord(infoPtr, framePtr, NULL, contextPtr);
 }
 
 void
@@ -1447,21 +1459,302 @@ Itcl_UnsetContext(
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
     ItclObjectInfo *infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
 	    ITCL_INTERP_DATA, NULL);
-    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr);
-    Itcl_Stack *stackPtr = (Itcl_Stack *) Tcl_GetHashValue(hPtr);
-    ItclCallContext *contextPtr = (ItclCallContext *)Itcl_PopStack(stackPtr);
+    ItclCallContext *contextPtr = ItclPopCallRecord(infoPtr, framePtr, NULL);
 
-    if (Itcl_GetStackSize(stackPtr) > 0) {
+    if (ItclPeekCallRecord(infoPtr, framePtr) != NULL) {
 	Tcl_Panic("frame context stack not empty!");
     }
-    Itcl_DeleteStack(stackPtr);
-    Tcl_Free(stackPtr);
-    Tcl_DeleteHashEntry(hPtr);
     if (contextPtr->refCount-- > 1) {
 	Tcl_Panic("frame context ref count not zero!");
     }
-    Tcl_Free(contextPtr);
+    ItclReleaseCallContext(infoPtr, contextPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclPushCallRecord()
+ *
+ *  Records the call context of a method call (or of an explicitly set
+ *  context) on top of the call records of the interp.  It can then be
+ *  found by the call frame with ItclPeekCallRecord() and removed again
+ *  with ItclPopCallRecord().  Records are recycled, so this normally
+ *  does not allocate.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclPushCallRecord(
+    ItclObjectInfo *infoPtr,	 /* info for this interp */
+    Tcl_CallFrame *framePtr,	 /* frame of the call */
+    Tcl_ObjectContext contextPtr,/* TclOO context of the call or NULL */
+    ItclCallContext *callContextPtr)
+{
+    ItclCallRecord *recPtr = infoPtr->freeCallRecords;
+
+    if (recPtr != NULL) {
+	infoPtr->freeCallRecords = recPtr->outerPtr;
+    } else {
+	recPtr = (ItclCallRecord *)Tcl_Alloc(sizeof(ItclCallRecord));
+    }
+    recPtr->framePtr = framePtr;
+    recPtr->contextPtr = contextPtr;
+    recPtr->callContextPtr = callContextPtr;
+    recPtr->frameEntry = NULL;
+    recPtr->contextEntry = NULL;
+    recPtr->innerPtr = NULL;
+    recPtr->outerPtr = infoPtr->callRecords;
+    if (recPtr->outerPtr != NULL) {
+	recPtr->outerPtr->innerPtr = recPtr;
+    }
+    infoPtr->callRecords = recPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  IndexCallRecords()
+ *
+ *  Enters the call records that are not indexed yet into the
+ *  frameContext and contextCallRecords tables.  These are always the
+ *  ones at the top of the stack, as records are only pushed there.
+ *  They are entered from the outermost one on, so each table entry
+ *  ends up with the innermost record of its key.
+ * ------------------------------------------------------------------------
+ */
+static void
+IndexCallRecords(
+    ItclObjectInfo *infoPtr)	 /* info for this interp */
+{
+    ItclCallRecord *recPtr = infoPtr->callRecords;
+    Tcl_HashEntry *hPtr;
+    int isNew;
+
+    if ((recPtr == NULL) || (recPtr->frameEntry != NULL)) {
+	return;
+    }
+    while ((recPtr->outerPtr != NULL)
+	    && (recPtr->outerPtr->frameEntry == NULL)) {
+	recPtr = recPtr->outerPtr;
+    }
+    for ( ; recPtr != NULL; recPtr = recPtr->innerPtr) {
+	hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
+		(char *)recPtr->framePtr, &isNew);
+	recPtr->nextFramePtr = isNew ? NULL
+		: (ItclCallRecord *)Tcl_GetHashValue(hPtr);
+	recPtr->frameEntry = hPtr;
+	Tcl_SetHashValue(hPtr, recPtr);
+
+	if (recPtr->contextPtr != NULL) {
+	    hPtr = Tcl_CreateHashEntry(&infoPtr->contextCallRecords,
+		    (char *)recPtr->contextPtr, &isNew);
+	    recPtr->nextContextPtr = isNew ? NULL
+		    : (ItclCallRecord *)Tcl_GetHashValue(hPtr);
+	    recPtr->contextEntry = hPtr;
+	    Tcl_SetHashValue(hPtr, recPtr);
+	}
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  FindCallRecord()
+ *
+ *  Returns the innermost call record for a TclOO context or, if
+ *  contextPtr is NULL, for a call frame, or NULL if there is none.
+ * ------------------------------------------------------------------------
+ */
+static ItclCallRecord *
+FindCallRecord(
+    ItclObjectInfo *infoPtr,	 /* info for this interp */
+    Tcl_CallFrame *framePtr,	 /* frame to look for */
+    Tcl_ObjectContext contextPtr)/* TclOO context to look for or NULL */
+{
+    ItclCallRecord *recPtr = infoPtr->callRecords;
+    Tcl_HashEntry *hPtr;
+
+    if (recPtr == NULL) {
+	return NULL;
+    }
+    if ((contextPtr != NULL) ? (recPtr->contextPtr == contextPtr)
+	    : (recPtr->framePtr == framePtr)) {
+	return recPtr;
+    }
+
+    /*
+     *  Not the innermost call, which happens with coroutines or when
+     *  the frame has no record at all.
+     */
+    IndexCallRecords(infoPtr);
+    if (contextPtr != NULL) {
+	hPtr = Tcl_FindHashEntry(&infoPtr->contextCallRecords,
+		(char *)contextPtr);
+    } else {
+	hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)framePtr);
+    }
+    if (hPtr == NULL) {
+	return NULL;
+    }
+    return (ItclCallRecord *)Tcl_GetHashValue(hPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclPopCallRecord()
+ *
+ *  Removes the innermost record for a TclOO context or, if contextPtr
+ *  is NULL, for a call frame.  Coroutines may finish calls out of
+ *  order, so the record need not be on top of the stack.  Returns the
+ *  call context of the removed record or NULL if there is none.
+ * ------------------------------------------------------------------------
+ */
+ItclCallContext *
+ItclPopCallRecord(
+    ItclObjectInfo *infoPtr,	 /* info for this interp */
+    Tcl_CallFrame *framePtr,	 /* frame to look for */
+    Tcl_ObjectContext contextPtr)/* TclOO context to look for or NULL */
+{
+    ItclCallRecord *recPtr;
+    ItclCallRecord *prevPtr;
+
+    recPtr = FindCallRecord(infoPtr, framePtr, contextPtr);
+    if (recPtr == NULL) {
+	return NULL;
+    }
+
+    /*
+     *  Unlink the record from the stack ...
+     */
+    if (recPtr->innerPtr != NULL) {
+	recPtr->innerPtr->outerPtr = recPtr->outerPtr;
+    } else {
+	infoPtr->callRecords = recPtr->outerPtr;
+    }
+    if (recPtr->outerPtr != NULL) {
+	recPtr->outerPtr->innerPtr = recPtr->innerPtr;
+    }
+
+    /*
+     *  ... and, if it was indexed, from the chains of its frame and of
+     *  its TclOO context.
+     */
+    if (recPtr->frameEntry != NULL) {
+	prevPtr = (ItclCallRecord *)Tcl_GetHashValue(recPtr->frameEntry);
+	if (prevPtr == recPtr) {
+	    if (recPtr->nextFramePtr == NULL) {
+		Tcl_DeleteHashEntry(recPtr->frameEntry);
+	    } else {
+		Tcl_SetHashValue(recPtr->frameEntry, recPtr->nextFramePtr);
+	    }
+	} else {
+	    while (prevPtr->nextFramePtr != recPtr) {
+		prevPtr = prevPtr->nextFramePtr;
+	    }
+	    prevPtr->nextFramePtr = recPtr->nextFramePtr;
+	}
+    }
+    if (recPtr->contextEntry != NULL) {
+	prevPtr = (ItclCallRecord *)Tcl_GetHashValue(recPtr->contextEntry);
+	if (prevPtr == recPtr) {
+	    if (recPtr->nextContextPtr == NULL) {
+		Tcl_DeleteHashEntry(recPtr->contextEntry);
+	    } else {
+		Tcl_SetHashValue(recPtr->contextEntry, recPtr->nextContextPtr);
+	    }
+	} else {
+	    while (prevPtr->nextContextPtr != recPtr) {
+		prevPtr = prevPtr->nextContextPtr;
+	    }
+	    prevPtr->nextContextPtr = recPtr->nextContextPtr;
+	}
+    }
+
+    recPtr->outerPtr = infoPtr->freeCallRecords;
+    infoPtr->freeCallRecords = recPtr;
+    return recPtr->callContextPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclPeekCallRecord()
+ *
+ *  Returns the innermost call context recorded for a call frame or
+ *  NULL if the frame has none.
+ * ------------------------------------------------------------------------
+ */
+ItclCallContext *
+ItclPeekCallRecord(
+    ItclObjectInfo *infoPtr,	 /* info for this interp */
+    Tcl_CallFrame *framePtr)	 /* frame to look for */
+{
+    ItclCallRecord *recPtr = FindCallRecord(infoPtr, framePtr, NULL);
+
+    if (recPtr == NULL) {
+	return NULL;
+    }
+    return recPtr->callContextPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeCallRecords()
+ *
+ *  Frees all call records and pooled call contexts of an interp, when
+ *  its Itcl data goes away.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeCallRecords(
+    ItclObjectInfo *infoPtr)	 /* info for this interp */
+{
+    ItclCallRecord *recPtr;
+    ItclCallContext *contextPtr;
+
+    while ((recPtr = infoPtr->callRecords) != NULL) {
+	infoPtr->callRecords = recPtr->outerPtr;
+	Tcl_Free(recPtr);
+    }
+    Tcl_DeleteHashTable(&infoPtr->frameContext);
+    Tcl_DeleteHashTable(&infoPtr->contextCallRecords);
+    while ((recPtr = infoPtr->freeCallRecords) != NULL) {
+	infoPtr->freeCallRecords = recPtr->outerPtr;
+	Tcl_Free(recPtr);
+    }
+    while ((contextPtr = infoPtr->freeCallContexts) != NULL) {
+	infoPtr->freeCallContexts = contextPtr->nextPtr;
+	Tcl_Free(contextPtr);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclAllocCallContext()
+ *
+ *  Returns a call context from the pool of the interp, or a new one if
+ *  the pool is empty.  The caller has to fill in all fields.  Give it
+ *  back with ItclReleaseCallContext().
+ * ------------------------------------------------------------------------
+ */
+ItclCallContext *
+ItclAllocCallContext(
+    ItclObjectInfo *infoPtr)	 /* info for this interp */
+{
+    ItclCallContext *contextPtr = infoPtr->freeCallContexts;
+
+    if (contextPtr != NULL) {
+	infoPtr->freeCallContexts = contextPtr->nextPtr;
+    } else {
+	contextPtr = (ItclCallContext *)Tcl_Alloc(sizeof(ItclCallContext));
+    }
+    contextPtr->isCached = 0;
+    contextPtr->nextPtr = NULL;
+    return contextPtr;
+}
+
+void
+ItclReleaseCallContext(
+    ItclObjectInfo *infoPtr,	 /* info for this interp */
+    ItclCallContext *contextPtr) /* context no longer in use */
+{
+    contextPtr->nextPtr = infoPtr->freeCallContexts;
+    infoPtr->freeCallContexts = contextPtr;
 }
 
 int
@@ -1475,18 +1768,13 @@ Itcl_GetContext(
     /* Fetch the current call frame.  That determines context. */
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
 
-    /* Try to map it to a context stack. */
+    /* Try to map it to a call context. */
     ItclObjectInfo *infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
 	    ITCL_INTERP_DATA, NULL);
-    Tcl_HashEntry *hPtr = Tcl_FindHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr);
-    if (hPtr) {
-	/* Frame maps to a context stack. */
-	Itcl_Stack *stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-	ItclCallContext *contextPtr = (ItclCallContext *)Itcl_PeekStack(stackPtr);
-
-	assert(contextPtr);
+    ItclCallContext *contextPtr = ItclPeekCallRecord(infoPtr, framePtr);
+    Tcl_HashEntry *hPtr;
 
+    if (contextPtr) {
 	if (contextPtr->objectFlags & ITCL_OBJECT_ROOT_METHOD) {
 	    ItclObject *ioPtr = contextPtr->ioPtr;
 
@@ -2137,7 +2425,6 @@ Itcl_CmdAliasProc(
     void *clientData)
 {
     Tcl_HashEntry *hPtr;
-    Tcl_Obj *objPtr;
     ItclObjectInfo *infoPtr;
     ItclClass *iclsPtr;
     ItclObject *ioPtr;
@@ -2159,9 +2446,7 @@ Itcl_CmdAliasProc(
 	return NULL;
     }
     iclsPtr = (ItclClass *)Tcl_GetHashValue(hPtr);
-    objPtr = Tcl_NewStringObj(cmdName, TCL_INDEX_NONE);
-    hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmds, (char *)objPtr);
-    Tcl_DecrRefCount(objPtr);
+    hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmdNames, cmdName);
     if (hPtr == NULL) {
 	if (strcmp(cmdName, "@itcl-builtin-cget") == 0) {
 	    return Tcl_FindCommand(interp, "::itcl::builtin::cget", NULL, 0);
@@ -2262,7 +2547,6 @@ Itcl_VarAliasProc(
     Tcl_Var varPtr;
 
     varPtr = NULL;
-    hPtr = NULL;
     callContextPtr = NULL;
     resolveInfoPtr = (ItclResolveInfo *)clientData;
     if (resolveInfoPtr->flags & ITCL_RESOLVE_OBJECT) {
@@ -2342,6 +2626,73 @@ ItclCheckCallProc(
     return result;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  GetCachedCallContext()
+ *
+ *  Looks for the call context of a method in the inline cache of an
+ *  object.  An idle context is reinitialized for this call, a busy one
+ *  (recursion) is shared only if the object flags and the current
+ *  namespace are unchanged.  On a miss, a free slot or else an idle
+ *  context of another method is taken over.  Returns NULL if the
+ *  caller has to use an uncached context.
+ * ------------------------------------------------------------------------
+ */
+static ItclCallContext *
+GetCachedCallContext(
+    ItclObjectInfo *infoPtr,
+    ItclObject *ioPtr,
+    ItclMemberFunc *imPtr,
+    Tcl_Namespace *nsPtr)
+{
+    ItclCallContext *contextPtr;
+    int i;
+    int slot = -1;
+
+    for (i = 0; i < ITCL_CONTEXT_SLOTS; i++) {
+	contextPtr = ioPtr->contextSlots[i];
+	if (contextPtr == NULL) {
+	    if (slot < 0) {
+		slot = i;
+	    }
+	} else if (contextPtr->imPtr == imPtr) {
+	    if (contextPtr->refCount == 0) {
+		goto initContext;
+	    }
+	    if ((contextPtr->objectFlags == ioPtr->flags)
+		    && (contextPtr->nsPtr == nsPtr)) {
+		contextPtr->refCount++;
+		return contextPtr;
+	    }
+	    return NULL;
+	}
+    }
+    if (slot >= 0) {
+	contextPtr = ItclAllocCallContext(infoPtr);
+	contextPtr->isCached = 1;
+	ioPtr->contextSlots[slot] = contextPtr;
+    } else {
+	for (i = 0; i < ITCL_CONTEXT_SLOTS; i++) {
+	    slot = (ioPtr->nextContextSlot + i) % ITCL_CONTEXT_SLOTS;
+	    if (ioPtr->contextSlots[slot]->refCount == 0) {
+		break;
+	    }
+	}
+	if (i == ITCL_CONTEXT_SLOTS) {
+	    return NULL;
+	}
+	ioPtr->nextContextSlot = (slot + 1) % ITCL_CONTEXT_SLOTS;
+	contextPtr = ioPtr->contextSlots[slot];
+    }
+initContext:
+    contextPtr->objectFlags = ioPtr->flags;
+    contextPtr->nsPtr = nsPtr;
+    contextPtr->ioPtr = ioPtr;
+    contextPtr->imPtr = imPtr;
+    contextPtr->refCount = 1;
+    return contextPtr;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclCheckCallMethod()
@@ -2357,25 +2708,19 @@ ItclCheckCallMethod(
     Tcl_CallFrame *framePtr,
     int *isFinished)
 {
-    Itcl_Stack *stackPtr;
-
     Tcl_Object oPtr;
     ItclObject *ioPtr;
-    Tcl_HashEntry *hPtr;
     Tcl_Obj *const * cObjv;
     Tcl_Namespace *currNsPtr;
     ItclCallContext *callContextPtr;
-    ItclCallContext *callContextPtr2;
     ItclMemberFunc *imPtr;
     int result;
-    int isNew;
     Tcl_Size cObjc;
     Tcl_Size min_allowed_args;
 
     ItclObjectInfo *infoPtr;
 
     oPtr = NULL;
-    hPtr = NULL;
     imPtr = (ItclMemberFunc *)clientData;
     Itcl_PreserveData(imPtr);
     if (imPtr->flags & ITCL_CONSTRUCTOR) {
@@ -2439,32 +2784,15 @@ ItclCheckCallMethod(
 	goto finishReturn;
     }
   }
-    isNew = 0;
     callContextPtr = NULL;
     currNsPtr = Tcl_GetCurrentNamespace(interp);
+    infoPtr = imPtr->iclsPtr->infoPtr;
     if (ioPtr != NULL) {
-	hPtr = Tcl_CreateHashEntry(&ioPtr->contextCache, (char *)imPtr, &isNew);
-	if (!isNew) {
-	    callContextPtr2 = (ItclCallContext *)Tcl_GetHashValue(hPtr);
-	    if (callContextPtr2->refCount == 0) {
-		callContextPtr = callContextPtr2;
-		callContextPtr->objectFlags = ioPtr->flags;
-		callContextPtr->nsPtr = Tcl_GetCurrentNamespace(interp);
-		callContextPtr->ioPtr = ioPtr;
-		callContextPtr->imPtr = imPtr;
-		callContextPtr->refCount = 1;
-	    } else {
-	      if ((callContextPtr2->objectFlags == ioPtr->flags)
-		    && (callContextPtr2->nsPtr == currNsPtr)) {
-		callContextPtr = callContextPtr2;
-		callContextPtr->refCount++;
-	      }
-	    }
-	}
+	callContextPtr = GetCachedCallContext(infoPtr, ioPtr, imPtr,
+		currNsPtr);
     }
     if (callContextPtr == NULL) {
-	callContextPtr = (ItclCallContext *)Tcl_Alloc(
-		sizeof(ItclCallContext));
+	callContextPtr = ItclAllocCallContext(infoPtr);
 	if (ioPtr == NULL) {
 	    callContextPtr->objectFlags = 0;
 	    callContextPtr->ioPtr = NULL;
@@ -2472,45 +2800,17 @@ ItclCheckCallMethod(
 	    callContextPtr->objectFlags = ioPtr->flags;
 	    callContextPtr->ioPtr = ioPtr;
 	}
-	callContextPtr->nsPtr = Tcl_GetCurrentNamespace(interp);
+	callContextPtr->nsPtr = currNsPtr;
 	callContextPtr->imPtr = imPtr;
 	callContextPtr->refCount = 1;
     }
-    if (isNew) {
-	Tcl_SetHashValue(hPtr, callContextPtr);
-    }
 
     if (framePtr == NULL) {
 	framePtr = Itcl_GetUplevelCallFrame(interp, 0);
     }
 
-    isNew = 0;
-    infoPtr = imPtr->iclsPtr->infoPtr;
-    hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
-	    (char *)framePtr, &isNew);
-    if (isNew) {
-	stackPtr = (Itcl_Stack *)Tcl_Alloc(sizeof(Itcl_Stack));
-	Itcl_InitStack(stackPtr);
-	Tcl_SetHashValue(hPtr, stackPtr);
-    } else {
-	stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    }
-
     assert (callContextPtr) ;
-    Itcl_PushStack(callContextPtr, stackPtr);
-
-    /* Ugly abuse alert.  Two maps in one table */
-    hPtr = Tcl_CreateHashEntry(&infoPtr->frameContext,
-	    (char *)contextPtr, &isNew);
-    if (isNew) {
-	stackPtr = (Itcl_Stack *)Tcl_Alloc(sizeof(Itcl_Stack));
-	Itcl_InitStack(stackPtr);
-	Tcl_SetHashValue(hPtr, stackPtr);
-    } else {
-	stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    }
-
-    Itcl_PushStack(framePtr, stackPtr);
+    ItclPushCallRecord(infoPtr, framePtr, contextPtr, callContextPtr);
 
     if (ioPtr != NULL) {
 	ioPtr->callRefCount++;
@@ -2546,7 +2846,6 @@ ItclAfterCallMethod(
     TCL_UNUSED(Tcl_Namespace*),
     int call_result)
 {
-    Tcl_HashEntry *hPtr;
     ItclObject *ioPtr;
     ItclMemberFunc *imPtr;
     ItclCallContext *callContextPtr;
@@ -2556,29 +2855,8 @@ ItclAfterCallMethod(
     imPtr = (ItclMemberFunc *)clientData;
     callContextPtr = NULL;
     if (contextPtr != NULL) {
-    ItclObjectInfo *infoPtr = imPtr->infoPtr;
-    Tcl_CallFrame *framePtr;
-    Itcl_Stack *stackPtr;
-
-    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)contextPtr);
-    assert(hPtr);
-    stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    framePtr = (Tcl_CallFrame *)Itcl_PopStack(stackPtr);
-    if (Itcl_GetStackSize(stackPtr) == 0) {
-	Itcl_DeleteStack(stackPtr);
-	Tcl_Free(stackPtr);
-	Tcl_DeleteHashEntry(hPtr);
-    }
-
-    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)framePtr);
-    assert(hPtr);
-    stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    callContextPtr = (ItclCallContext *)Itcl_PopStack(stackPtr);
-    if (Itcl_GetStackSize(stackPtr) == 0) {
-	Itcl_DeleteStack(stackPtr);
-	Tcl_Free(stackPtr);
-	Tcl_DeleteHashEntry(hPtr);
-    }
+	callContextPtr = ItclPopCallRecord(imPtr->infoPtr, NULL, contextPtr);
+	assert(callContextPtr);
     }
     if (callContextPtr == NULL) {
 	if ((imPtr->flags & ITCL_COMMON) ||
@@ -2602,17 +2880,9 @@ ItclAfterCallMethod(
     if (ioPtr != NULL) {
       if (imPtr->iclsPtr) {
 	imPtr->iclsPtr->callRefCount--;
-	if (imPtr->flags & (ITCL_CONSTRUCTOR | ITCL_DESTRUCTOR)) {
-	    if ((imPtr->flags & ITCL_DESTRUCTOR) && ioPtr &&
-		 ioPtr->destructed) {
-		Tcl_CreateHashEntry(ioPtr->destructed,
-		    (char *)imPtr->iclsPtr->namePtr, &newEntry);
-	    }
-	    if ((imPtr->flags & ITCL_CONSTRUCTOR) && ioPtr &&
-		 ioPtr->constructed) {
-		Tcl_CreateHashEntry(ioPtr->constructed,
-		    (char *)imPtr->iclsPtr->namePtr, &newEntry);
-	    }
+	if ((imPtr->flags & ITCL_CONSTRUCTOR) && ioPtr->constructed) {
+	    Tcl_CreateHashEntry(ioPtr->constructed,
+		(char *)imPtr->iclsPtr->namePtr, &newEntry);
 	}
       }
 	ioPtr->callRefCount--;
@@ -2621,16 +2891,8 @@ ItclAfterCallMethod(
 	}
     }
 
-    if (callContextPtr->refCount-- <= 1) {
-	if (callContextPtr->ioPtr != NULL) {
-	    hPtr = Tcl_FindHashEntry(&callContextPtr->ioPtr->contextCache,
-		    (char *)callContextPtr->imPtr);
-	    if (hPtr == NULL) {
-		Tcl_Free(callContextPtr);
-	    }
-	} else {
-	    Tcl_Free(callContextPtr);
-	}
+    if ((callContextPtr->refCount-- <= 1) && !callContextPtr->isCached) {
+	ItclReleaseCallContext(imPtr->infoPtr, callContextPtr);
     }
 
     if (ioPtr != NULL) {
@@ -2655,25 +2917,16 @@ ItclProcErrorProc(
     ItclObject *contextIoPtr;
     ItclClass *currIclsPtr;
     char num[20];
-    Itcl_Stack *stackPtr;
 
     /* Fetch the current call frame.  That determines context. */
     Tcl_CallFrame *framePtr = Itcl_GetUplevelCallFrame(interp, 0);
 
-    /* Try to map it to a context stack. */
+    /* Try to map it to a call context. */
     infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
 	    ITCL_INTERP_DATA, NULL);
-    hPtr = Tcl_FindHashEntry(&infoPtr->frameContext, (char *)framePtr);
-    if (hPtr == NULL) {
-	/* Can this happen? */
-	return;
-    }
-
-    /* Frame maps to a context stack. */
-    stackPtr = (Itcl_Stack *)Tcl_GetHashValue(hPtr);
-    callContextPtr = (ItclCallContext *)Itcl_PeekStack(stackPtr);
-
+    callContextPtr = ItclPeekCallRecord(infoPtr, framePtr);
     if (callContextPtr == NULL) {
+	/* Can this happen? */
 	return;
     }
 
@@ -92,6 +92,138 @@ Itcl_ReleaseVar(
     TclCleanupVar(varPtr, NULL);
 }
 
+/*
+ * Returns the element "keyPtr" of the array variable "arrayVar", or NULL
+ * if the variable isn't an array or has no such element.  The caller
+ * must preserve the element if it keeps it.
+ */
+Tcl_Var
+Itcl_FindArrayElement(
+    Tcl_Var arrayVar,
+    Tcl_Obj *keyPtr)
+{
+    Var *arrayPtr = (Var *)arrayVar;
+    Var *varPtr;
+
+    if ((arrayPtr == NULL) || !TclIsVarArray(arrayPtr)
+	    || TclIsVarUndefined(arrayPtr)) {
+	return NULL;
+    }
+    varPtr = TclVarHashFindVar(arrayPtr->value.tablePtr,
+	    Tcl_GetString(keyPtr));
+    if ((varPtr == NULL) || TclIsVarUndefined(varPtr)) {
+	return NULL;
+    }
+    return (Tcl_Var)varPtr;
+}
+
+/*
+ * Returns 1 if a preserved variable still holds a value, 0 if it was
+ * unset or deleted together with its array or namespace.
+ */
+int
+Itcl_IsVarDefined(
+    Tcl_Var var)
+{
+    Var *varPtr = (Var *)var;
+
+    return !TclIsVarDeadHash(varPtr) && !TclIsVarUndefined(varPtr);
+}
+
+/*
+ * Returns the value of an element of an array without going through the
+ * variable lookup, or NULL if the array or the element is traced, or the
+ * element is not a plain scalar.  The caller then has to use the usual
+ * Tcl_GetVar2() path.
+ */
+Tcl_Obj *
+Itcl_GetPlainElement(
+    Tcl_Var arrayVar,
+    Tcl_Var elemVar)
+{
+    Var *arrayPtr = (Var *)arrayVar;
+    Var *varPtr = (Var *)elemVar;
+
+    if (TclIsVarTraced(arrayPtr) || TclIsVarTraced(varPtr)
+	    || TclIsVarDeadHash(varPtr) || !TclIsVarScalar(varPtr)) {
+	return NULL;
+    }
+    return varPtr->value.objPtr;
+}
+
+/*
+ * Stores a new value in an element of an array that has a value already.
+ * Returns 0 without doing anything under the same conditions as
+ * Itcl_GetPlainElement().
+ */
+int
+Itcl_SetPlainElement(
+    Tcl_Var arrayVar,
+    Tcl_Var elemVar,
+    Tcl_Obj *valuePtr)
+{
+    Var *arrayPtr = (Var *)arrayVar;
+    Var *varPtr = (Var *)elemVar;
+    Tcl_Obj *oldValuePtr;
+
+    if (TclIsVarTraced(arrayPtr) || TclIsVarTraced(varPtr)
+	    || TclIsVarDeadHash(varPtr) || !TclIsVarScalar(varPtr)
+	    || (varPtr->value.objPtr == NULL)) {
+	return 0;
+    }
+    oldValuePtr = varPtr->value.objPtr;
+    if (oldValuePtr != valuePtr) {
+	Tcl_IncrRefCount(valuePtr);
+	varPtr->value.objPtr = valuePtr;
+	Tcl_DecrRefCount(oldValuePtr);
+    }
+    return 1;
+}
+
+/*
+ * Returns the value of a scalar variable without going through the
+ * variable lookup, or NULL if the variable is traced, unset or not a
+ * plain scalar.  The caller then has to use the usual Tcl_GetVar2() path.
+ */
+Tcl_Obj *
+Itcl_GetPlainVar(
+    Tcl_Var var)
+{
+    Var *varPtr = (Var *)var;
+
+    if (TclIsVarTraced(varPtr) || TclIsVarDeadHash(varPtr)
+	    || !TclIsVarScalar(varPtr)) {
+	return NULL;
+    }
+    return varPtr->value.objPtr;
+}
+
+/*
+ * Stores a new value in a scalar variable that has a value already.
+ * Returns 0 without doing anything under the same conditions as
+ * Itcl_GetPlainVar().
+ */
+int
+Itcl_SetPlainVar(
+    Tcl_Var var,
+    Tcl_Obj *valuePtr)
+{
+    Var *varPtr = (Var *)var;
+    Tcl_Obj *oldValuePtr;
+
+    if (TclIsVarTraced(varPtr) || TclIsVarDeadHash(varPtr)
+	    || !TclIsVarScalar(varPtr) || (varPtr->value.objPtr == NULL)) {
+	return 0;
+    }
+    oldValuePtr = varPtr->value.objPtr;
+    if (oldValuePtr != valuePtr) {
+	Tcl_IncrRefCount(valuePtr);
+	varPtr->value.objPtr = valuePtr;
+	Tcl_DecrRefCount(oldValuePtr);
+    }
+    return 1;
+}
+
 Tcl_CallFrame *
 Itcl_GetUplevelCallFrame(
     Tcl_Interp *interp,
@@ -75,6 +75,15 @@ MODULE_SCOPE Tcl_Var Tcl_NewNamespaceVar(Tcl_Interp *interp, Tcl_Namespace *nsPt
 	const char *varName);
 MODULE_SCOPE void Itcl_PreserveVar(Tcl_Var var);
 MODULE_SCOPE void Itcl_ReleaseVar(Tcl_Var var);
+MODULE_SCOPE Tcl_Var Itcl_FindArrayElement(Tcl_Var arrayVar,
+	Tcl_Obj *keyPtr);
+MODULE_SCOPE int Itcl_IsVarDefined(Tcl_Var var);
+MODULE_SCOPE Tcl_Obj *Itcl_GetPlainElement(Tcl_Var arrayVar,
+	Tcl_Var elemVar);
+MODULE_SCOPE int Itcl_SetPlainElement(Tcl_Var arrayVar, Tcl_Var elemVar,
+	Tcl_Obj *valuePtr);
+MODULE_SCOPE Tcl_Obj *Itcl_GetPlainVar(Tcl_Var var);
+MODULE_SCOPE int Itcl_SetPlainVar(Tcl_Var var, Tcl_Obj *valuePtr);
 MODULE_SCOPE int Itcl_IsCallFrameArgument(Tcl_Interp *interp, const char *name);
 MODULE_SCOPE size_t Itcl_GetCallVarFrameObjc(Tcl_Interp *interp);
 MODULE_SCOPE Tcl_Obj *const * Itcl_GetCallVarFrameObjv(Tcl_Interp *interp);
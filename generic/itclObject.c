@@ -35,6 +35,9 @@
 /*
  *  FORWARD DECLARATIONS
  */
+static Tcl_Obj *BuiltinVarValue(ItclObject *ioPtr, int kind);
+static int BuiltinVarKind(ItclVariable *ivPtr);
+static void UpdateBuiltinVars(ItclObject *ioPtr, int mask);
 static char* ItclTraceThisVar(void *cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
 static char* ItclTraceTypeVar(void *cdata, Tcl_Interp *interp,
@@ -45,18 +48,20 @@ static char* ItclTraceSelfnsVar(void *cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
 static char* ItclTraceWinVar(void *cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
-static char* ItclTraceOptionVar(void *cdata, Tcl_Interp *interp,
-	const char *name1, const char *name2, int flags);
 static char* ItclTraceComponentVar(void *cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
 static char* ItclTraceItclHullVar(void *cdata, Tcl_Interp *interp,
 	const char *name1, const char *name2, int flags);
+static void ForgetComponentDelegations(ItclObject *ioPtr,
+	ItclComponent *icPtr);
 
 static void ItclDestroyObject(void *clientData);
 static void FreeObject(char *cdata);
+static void AddObjectInstance(ItclObject *ioPtr);
+static void RemoveObjectInstance(ItclObject *ioPtr);
 
 static int ItclDestructBase(Tcl_Interp *interp, ItclObject *contextObj,
-	ItclClass *contextClass, int flags);
+	int flags);
 
 static int ItclInitObjectVariables(Tcl_Interp *interp, ItclObject *ioPtr,
 	ItclClass *iclsPtr);
@@ -119,6 +124,7 @@ ObjectRenamedTrace(
 
     if (newName != NULL) {
 	/* FIXME should enter the new name in the hashtables for objects etc. */
+	UpdateBuiltinVars(ioPtr, ITCL_THIS_VAR|ITCL_SELF_VAR);
 	return;
     }
     if (ioPtr->flags & ITCL_OBJECT_CLASS_DESTRUCTED) {
@@ -138,6 +144,69 @@ ObjectRenamedTrace(
 	ioPtr->flags |= ITCL_OBJECT_CLASS_DESTRUCTED;
     }
 }
+
+/*
+ * ------------------------------------------------------------------------
+ *  AddObjectInstance()
+ *
+ *  Appends an object to the instance list of its class, unless it is
+ *  already there.  The list holds the same objects as the "objects"
+ *  table of the interp, but only those of one class, so that deleting
+ *  or listing the instances of a class does not scan all objects.
+ * ------------------------------------------------------------------------
+ */
+static void
+AddObjectInstance(
+    ItclObject *ioPtr)
+{
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
+
+    if ((ioPtr->prevInstancePtr != NULL)
+	    || (iclsPtr->firstInstancePtr == ioPtr)) {
+	return;
+    }
+    ioPtr->prevInstancePtr = iclsPtr->lastInstancePtr;
+    ioPtr->nextInstancePtr = NULL;
+    if (iclsPtr->lastInstancePtr != NULL) {
+	iclsPtr->lastInstancePtr->nextInstancePtr = ioPtr;
+    } else {
+	iclsPtr->firstInstancePtr = ioPtr;
+    }
+    iclsPtr->lastInstancePtr = ioPtr;
+    iclsPtr->numInstances++;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  RemoveObjectInstance()
+ *
+ *  Takes an object off the instance list of its class, if it is on it.
+ * ------------------------------------------------------------------------
+ */
+static void
+RemoveObjectInstance(
+    ItclObject *ioPtr)
+{
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
+
+    if ((ioPtr->prevInstancePtr == NULL)
+	    && (iclsPtr->firstInstancePtr != ioPtr)) {
+	return;
+    }
+    if (ioPtr->prevInstancePtr != NULL) {
+	ioPtr->prevInstancePtr->nextInstancePtr = ioPtr->nextInstancePtr;
+    } else {
+	iclsPtr->firstInstancePtr = ioPtr->nextInstancePtr;
+    }
+    if (ioPtr->nextInstancePtr != NULL) {
+	ioPtr->nextInstancePtr->prevInstancePtr = ioPtr->prevInstancePtr;
+    } else {
+	iclsPtr->lastInstancePtr = ioPtr->prevInstancePtr;
+    }
+    ioPtr->prevInstancePtr = NULL;
+    ioPtr->nextInstancePtr = NULL;
+    iclsPtr->numInstances--;
+}
 
 /*
  * ------------------------------------------------------------------------
@@ -254,8 +323,13 @@ ItclCreateObject(
     ioPtr->infoPtr = infoPtr;
     ItclPreserveClass(iclsPtr);
 
-    ioPtr->constructed = (Tcl_HashTable*)Tcl_Alloc(sizeof(Tcl_HashTable));
-    Tcl_InitObjHashTable(ioPtr->constructed);
+    if (!(iclsPtr->flags & ITCL_CLASS_LIFECYCLE_PLAN)) {
+	ItclBuildLifecyclePlan(iclsPtr);
+    }
+    if (iclsPtr->numConstructors > 0) {
+	ioPtr->constructed = (Tcl_HashTable*)Tcl_Alloc(sizeof(Tcl_HashTable));
+	Tcl_InitObjHashTable(ioPtr->constructed);
+    }
 
     ioPtr->oPtr = Tcl_NewObjectInstance(interp, iclsPtr->clsPtr, NULL,
 	    /* nsName */ NULL, /* objc */ -1, /* objv */ NULL, /* skip */ 0);
@@ -292,12 +366,6 @@ ItclCreateObject(
     Tcl_DStringFree(&buffer);
 
     Tcl_InitHashTable(&ioPtr->objectVariables, TCL_ONE_WORD_KEYS);
-    Tcl_InitObjHashTable(&ioPtr->objectOptions);
-    Tcl_InitObjHashTable(&ioPtr->objectComponents);
-    Tcl_InitObjHashTable(&ioPtr->objectDelegatedOptions);
-    Tcl_InitObjHashTable(&ioPtr->objectDelegatedFunctions);
-    Tcl_InitObjHashTable(&ioPtr->objectMethodVariables);
-    Tcl_InitHashTable(&ioPtr->contextCache, TCL_ONE_WORD_KEYS);
 
     Itcl_PreserveData(ioPtr);
 
@@ -439,6 +507,7 @@ ItclCreateObject(
     cmdInfo.deleteProc = ItclDestroyObject;
     cmdInfo.deleteData = ioPtr;
     Tcl_SetCommandInfoFromToken(ioPtr->accessCmd, &cmdInfo);
+    UpdateBuiltinVars(ioPtr, ITCL_THIS_VAR|ITCL_SELF_VAR);
     ioPtr->resolvePtr = (Tcl_Resolve *)Tcl_Alloc(sizeof(Tcl_Resolve));
     ioPtr->resolvePtr->cmdProcPtr = Itcl_CmdAliasProc;
     ioPtr->resolvePtr->varProcPtr = Itcl_VarAliasProc;
@@ -459,6 +528,7 @@ ItclCreateObject(
     hPtr = Tcl_CreateHashEntry(&iclsPtr->infoPtr->objects,
 	(char*)ioPtr, &newEntry);
     Tcl_SetHashValue(hPtr, ioPtr);
+    AddObjectInstance(ioPtr);
 
     /* Use the TclOO object namespaces as a unique key in case the
      * object is renamed. Used by mytypemethod, etc. */
@@ -478,8 +548,12 @@ ItclCreateObject(
      */
     ItclShowArgs(1, "OBJECTCONSTRUCTOR", objc, objv);
     ioPtr->hadConstructorError = 0;
-    result = Itcl_InvokeMethodIfExists(interp, "constructor",
-	iclsPtr, ioPtr, objc, objv);
+    if ((iclsPtr->numConstructors > 0) || (iclsPtr->flags
+	    & (ITCL_ECLASS|ITCL_TYPE|ITCL_WIDGET|ITCL_WIDGETADAPTOR))) {
+	/* types and widgets without one get a default constructor */
+	result = Itcl_InvokeMethodIfExists(interp, "constructor",
+		iclsPtr, ioPtr, objc, objv);
+    }
     if (ioPtr->hadConstructorError) {
 	result = TCL_ERROR;
     }
@@ -507,11 +581,13 @@ ItclCreateObject(
      *  in case they have constructors.  This will cause the
      *  same chain reaction.
      */
-    objPtr = Tcl_NewStringObj("constructor", TCL_INDEX_NONE);
-    if (Tcl_FindHashEntry(&iclsPtr->functions, (char *)objPtr) == NULL) {
-	result = Itcl_ConstructBase(interp, ioPtr, iclsPtr);
+    if (iclsPtr->numConstructors > 0) {
+	objPtr = Tcl_NewStringObj("constructor", TCL_INDEX_NONE);
+	if (Tcl_FindHashEntry(&iclsPtr->functions, (char *)objPtr) == NULL) {
+	    result = Itcl_ConstructBase(interp, ioPtr, iclsPtr);
+	}
+	Tcl_DecrRefCount(objPtr);
     }
-    Tcl_DecrRefCount(objPtr);
 
     if (iclsPtr->flags & ITCL_ECLASS) {
 	ItclInitExtendedClassOptions(interp, ioPtr);
@@ -623,6 +699,7 @@ ItclCreateObject(
 	hPtr = Tcl_CreateHashEntry(&iclsPtr->infoPtr->objects,
 		(char*)ioPtr, &newEntry);
 	Tcl_SetHashValue(hPtr, ioPtr);
+	AddObjectInstance(ioPtr);
 
 	/*
 	 * This is an inelegant hack, left behind until the need for it
@@ -683,10 +760,12 @@ ItclCreateObject(
 	infoPtr->currIoPtr = saveCurrIoPtr;
     }
     infoPtr->lastIoPtr = ioPtr;
-    Tcl_DeleteHashTable(ioPtr->constructed);
-    Tcl_Free(ioPtr->constructed);
-    ioPtr->constructed = NULL;
-    ItclAddObjectsDictInfo(interp, ioPtr);
+    if (ioPtr->constructed != NULL) {
+	Tcl_DeleteHashTable(ioPtr->constructed);
+	Tcl_Free(ioPtr->constructed);
+	ioPtr->constructed = NULL;
+    }
+    ioPtr->flags |= ITCL_OBJECT_IS_CONSTRUCTED;
     Itcl_ReleaseData(ioPtr);
     return result;
 
@@ -738,99 +817,370 @@ ItclInitObjectCommands(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclInitObjectVariables()
+ *  FlatVarName()
  *
- *  Init all instance variables and create the necessary variable namespaces
- *  for the given object instance.  This is usually invoked automatically
- *  by Itcl_CreateObject(), when an object is created.
+ *  Returns the name of an instance variable in the variables namespace
+ *  of objects of a class with ITCL_CLASS_FLAT_VARIABLES.  All variables
+ *  of such an object live in a single namespace instead of one per
+ *  class, so the name of the class is folded into the name of the
+ *  variable: "::a::Foo::x" is kept as "a:Foo:x".  Colons and percent
+ *  signs within the parts are written as "%3A" and "%25", so that
+ *  "::p::q:r" and "::p:q::r" do not end up as the same variable.
  * ------------------------------------------------------------------------
  */
-static int
-ItclInitObjectVariables(
-   Tcl_Interp *interp,
-   ItclObject *ioPtr,
-   ItclClass *iclsPtr)
+static Tcl_Obj *
+FlatVarName(
+    ItclVariable *ivPtr)
+{
+    const char *cp;
+    const char *start;
+
+    if (ivPtr->flatNamePtr != NULL) {
+	return ivPtr->flatNamePtr;
+    }
+    ivPtr->flatNamePtr = Tcl_NewObj();
+    Tcl_IncrRefCount(ivPtr->flatNamePtr);
+    cp = Tcl_GetString(ivPtr->fullNamePtr);
+    while (*cp == ':') {
+	cp++;
+    }
+    while (*cp != '\0') {
+	if ((cp[0] == ':') && (cp[1] == ':')) {
+	    Tcl_AppendToObj(ivPtr->flatNamePtr, ":", 1);
+	    while (*cp == ':') {
+		cp++;
+	    }
+	    continue;
+	}
+	if (*cp == ':') {
+	    Tcl_AppendToObj(ivPtr->flatNamePtr, "%3A", 3);
+	    cp++;
+	    continue;
+	}
+	if (*cp == '%') {
+	    Tcl_AppendToObj(ivPtr->flatNamePtr, "%25", 3);
+	    cp++;
+	    continue;
+	}
+	start = cp;
+	while ((*cp != '\0') && (*cp != ':') && (*cp != '%')) {
+	    cp++;
+	}
+	Tcl_AppendToObj(ivPtr->flatNamePtr, start, cp - start);
+    }
+    return ivPtr->flatNamePtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInstanceVarName()
+ *
+ *  Returns a new object holding the fully qualified name of the
+ *  instance variable "ivPtr" of the object "ioPtr", which is where
+ *  ItclInitObjectVariables() created it.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Obj *
+ItclInstanceVarName(
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr)
+{
+    Tcl_Obj *objPtr;
+
+    objPtr = Tcl_DuplicateObj(ioPtr->varNsNamePtr);
+    if (ioPtr->iclsPtr->flags & ITCL_CLASS_FLAT_VARIABLES) {
+	Tcl_AppendToObj(objPtr, "::", 2);
+	Tcl_AppendObjToObj(objPtr, FlatVarName(ivPtr));
+    } else {
+	Tcl_AppendObjToObj(objPtr, ivPtr->fullNamePtr);
+    }
+    return objPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclScopedVarName()
+ *
+ *  Returns a new object holding the name under which an instance
+ *  variable is shown to scripts, e.g. by "itcl::scope" and "info
+ *  variable -scope".  It is the name ItclInstanceVarName() returns for
+ *  objects with a namespace per class.  For objects of a class with
+ *  ITCL_CLASS_FLAT_VARIABLES that namespace and a link to the flat
+ *  variable are created on first use, so the name can be used the same
+ *  way in both layouts.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Obj *
+ItclScopedVarName(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclVariable *ivPtr)
 {
+    Tcl_Obj *objPtr;
+    Tcl_Obj *flatPtr;
+    Tcl_Namespace *nsPtr;
+    Tcl_CallFrame frame;
+    Tcl_InterpState state;
     Tcl_DString buffer;
-    Tcl_DString buffer2;
-    Tcl_HashEntry *hPtr;
+
+    objPtr = Tcl_DuplicateObj(ioPtr->varNsNamePtr);
+    Tcl_AppendObjToObj(objPtr, ivPtr->fullNamePtr);
+    if (!(ioPtr->iclsPtr->flags & ITCL_CLASS_FLAT_VARIABLES)) {
+	return objPtr;
+    }
+
+    state = Tcl_SaveInterpState(interp, TCL_OK);
+
+    Tcl_DStringInit(&buffer);
+    Tcl_DStringAppend(&buffer, Tcl_GetString(ioPtr->varNsNamePtr),
+	    TCL_INDEX_NONE);
+    Tcl_DStringAppend(&buffer, ivPtr->iclsPtr->nsPtr->fullName,
+	    TCL_INDEX_NONE);
+    nsPtr = Tcl_FindNamespace(interp, Tcl_DStringValue(&buffer), NULL, 0);
+    if (nsPtr == NULL) {
+	nsPtr = Tcl_CreateNamespace(interp, Tcl_DStringValue(&buffer),
+		NULL, NULL);
+    }
+    Tcl_DStringFree(&buffer);
+    if ((nsPtr == NULL) || (Tcl_FindNamespaceVar(interp,
+	    Tcl_GetString(ivPtr->namePtr), nsPtr, TCL_NAMESPACE_ONLY) != NULL)) {
+	Tcl_RestoreInterpState(interp, state);
+	return objPtr;
+    }
+    flatPtr = ItclInstanceVarName(ioPtr, ivPtr);
+    Tcl_IncrRefCount(flatPtr);
+    if (Itcl_PushCallFrame(interp, &frame, nsPtr,
+	    /*isProcCallFrame*/0) == TCL_OK) {
+	Tcl_UpVar2(interp, "#0", Tcl_GetString(flatPtr), NULL,
+		Tcl_GetString(ivPtr->namePtr), 0);
+	Itcl_PopCallFrame(interp);
+    }
+    Tcl_DecrRefCount(flatPtr);
+    Tcl_RestoreInterpState(interp, state);
+    return objPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclNewObjectExt()
+ *
+ *  Allocates the option, component, methodvariable and delegation
+ *  tables of an object.  Only objects of extended classes, types and
+ *  widgets fill them, so they are allocated on first use, see
+ *  ItclGetObjectExt().
+ * ------------------------------------------------------------------------
+ */
+ItclObjectExt *
+ItclNewObjectExt(void)
+{
+    ItclObjectExt *extPtr;
+
+    extPtr = (ItclObjectExt *)Tcl_Alloc(sizeof(ItclObjectExt));
+    Tcl_InitObjHashTable(&extPtr->objectOptions);
+    Tcl_InitObjHashTable(&extPtr->objectComponents);
+    Tcl_InitObjHashTable(&extPtr->objectMethodVariables);
+    Tcl_InitObjHashTable(&extPtr->objectDelegatedOptions);
+    Tcl_InitObjHashTable(&extPtr->objectDelegatedFunctions);
+    extPtr->optionSlots = NULL;
+    extPtr->numOptionSlots = 0;
+    Tcl_InitHashTable(&extPtr->delegationPlans, TCL_ONE_WORD_KEYS);
+    Tcl_InitHashTable(&extPtr->componentValues, TCL_ONE_WORD_KEYS);
+    return extPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeObjectExt()
+ *
+ *  Frees the tables allocated by ItclNewObjectExt().  The entries are
+ *  owned by the class members they point to, except for the objects
+ *  in delegationPlans and componentValues.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeObjectExt(
+    ItclObjectExt *extPtr)
+{
+    FOREACH_HASH_DECLS;
+    Tcl_Obj *prefixPtr;
+    Tcl_Size i;
+
+    if (extPtr->optionSlots != NULL) {
+	for (i = 0; i < extPtr->numOptionSlots; i++) {
+	    if (extPtr->optionSlots[i] != NULL) {
+		Itcl_ReleaseVar(extPtr->optionSlots[i]);
+	    }
+	}
+	Tcl_Free(extPtr->optionSlots);
+    }
+    Tcl_DeleteHashTable(&extPtr->objectOptions);
+    Tcl_DeleteHashTable(&extPtr->objectComponents);
+    Tcl_DeleteHashTable(&extPtr->objectMethodVariables);
+    Tcl_DeleteHashTable(&extPtr->objectDelegatedOptions);
+    Tcl_DeleteHashTable(&extPtr->objectDelegatedFunctions);
+    FOREACH_HASH_VALUE(prefixPtr, &extPtr->delegationPlans) {
+	Tcl_DecrRefCount(prefixPtr);
+    }
+    Tcl_DeleteHashTable(&extPtr->delegationPlans);
+    FOREACH_HASH_VALUE(prefixPtr, &extPtr->componentValues) {
+	Tcl_DecrRefCount(prefixPtr);
+    }
+    Tcl_DeleteHashTable(&extPtr->componentValues);
+    Tcl_Free(extPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetObjectExt()
+ *
+ *  Returns the option, component, methodvariable and delegation tables
+ *  of an object for adding entries, allocating them if needed.  Lookups
+ *  use ITCL_OBJECT_EXT() instead, which doesn't allocate.
+ * ------------------------------------------------------------------------
+ */
+ItclObjectExt *
+ItclGetObjectExt(
+    ItclObject *ioPtr)
+{
+    if (ioPtr->extPtr == NULL) {
+	ioPtr->extPtr = ItclNewObjectExt();
+    }
+    return ioPtr->extPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  AddInitStep()
+ *
+ *  Appends a step to the object initialization plan of a class.
+ *  "namePtr" is the name of the variable the step works on.
+ * ------------------------------------------------------------------------
+ */
+static ItclInitStep *
+AddInitStep(
+    ItclClass *iclsPtr,
+    Tcl_Size *sizePtr,
+    int op,
+    ItclVariable *ivPtr,
+    Tcl_Obj *namePtr)
+{
+    ItclInitStep *stepPtr;
+
+    if (iclsPtr->numInitSteps >= *sizePtr) {
+	*sizePtr = (*sizePtr == 0) ? 16 : 2 * *sizePtr;
+	iclsPtr->initPlan = (ItclInitStep *)Tcl_Realloc(iclsPtr->initPlan,
+		sizeof(ItclInitStep) * *sizePtr);
+    }
+    stepPtr = &iclsPtr->initPlan[iclsPtr->numInitSteps++];
+    memset(stepPtr, 0, sizeof(ItclInitStep));
+    stepPtr->op = op;
+    stepPtr->ivPtr = ivPtr;
+    stepPtr->slotIndex = -1;
+    if (namePtr != NULL) {
+	stepPtr->namePtr = namePtr;
+	Tcl_IncrRefCount(namePtr);
+    }
+    return stepPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  AddInitTrace()
+ *
+ *  Appends a step attaching a variable trace to the object
+ *  initialization plan of a class.
+ * ------------------------------------------------------------------------
+ */
+static void
+AddInitTrace(
+    ItclClass *iclsPtr,
+    Tcl_Size *sizePtr,
+    ItclVariable *ivPtr,
+    Tcl_Obj *namePtr,
+    int traceFlags,
+    Tcl_VarTraceProc *traceProc)
+{
+    ItclInitStep *stepPtr;
+
+    stepPtr = AddInitStep(iclsPtr, sizePtr, ITCL_INIT_TRACE, ivPtr, namePtr);
+    stepPtr->traceFlags = traceFlags;
+    stepPtr->traceProc = traceProc;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclBuildInitPlan()
+ *
+ *  Compiles the work needed to set up the variables of an object of
+ *  the given class into iclsPtr->initPlan.  Namespace paths, variable
+ *  slots, commons and traces are all resolved here, so that creating
+ *  an object only has to replay the plan.  The plan is built when the
+ *  first object of the class is created, just like the variable slots.
+ *  If the ITCL_FLAT_VARIABLES environment variable was set when Itcl
+ *  was loaded, objects of plain classes get all their instance
+ *  variables in the one variables namespace of the object rather than
+ *  in a namespace per class of the hierarchy.
+ *  Returns TCL_ERROR with a message in the interpreter if the class
+ *  cannot be instantiated; no plan is kept then.
+ * ------------------------------------------------------------------------
+ */
+static int
+ItclBuildInitPlan(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclClass *iclsPtr)
+{
+    FOREACH_HASH_DECLS;
     Tcl_HashEntry *hPtr2;
-    Tcl_HashSearch place;
-    Tcl_Namespace *varNsPtr;
-    Tcl_Namespace *varNsPtr2;
-    Tcl_CallFrame frame;
-    Tcl_Var varPtr;
-    ItclClass *iclsPtr2;
+    Tcl_Obj *objPtr;
+    Tcl_Obj *namePtr;
     ItclHierIter hier;
+    ItclClass *iclsPtr2;
     ItclVariable *ivPtr;
     ItclComponent *icPtr;
+    ItclInitStep *stepPtr;
+    Tcl_VarTraceProc *traceProc;
+    int traceFlags;
     const char *varName;
     const char *inheritComponentName;
+    Tcl_Size size;
     int itclOptionsIsSet;
-    int isNew;
+    int flat;
 
-    ivPtr = NULL;
-    /*
-     * create all the variables for each class in the
-     * ::itcl::variables::<object namespace>::<class> namespace as an
-     * undefined variable using the Tcl "variable xx" command
-     */
+    size = 0;
     itclOptionsIsSet = 0;
     inheritComponentName = NULL;
+    flat = iclsPtr->infoPtr->flatVariables;
     Itcl_InitHierIter(&hier, iclsPtr);
-    iclsPtr2 = Itcl_AdvanceHierIter(&hier);
-    Tcl_ResetResult(interp);
-    while (iclsPtr2 != NULL) {
-	Tcl_DStringInit(&buffer);
-	Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer,
-		(Tcl_GetObjectNamespace(ioPtr->oPtr))->fullName, TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer, iclsPtr2->nsPtr->fullName, TCL_INDEX_NONE);
-	varNsPtr = Tcl_FindNamespace(interp, Tcl_DStringValue(&buffer),
-		NULL, 0);
-	if (varNsPtr == NULL) {
-	    varNsPtr = Tcl_CreateNamespace(interp, Tcl_DStringValue(&buffer),
-		    NULL, 0);
+    while (flat && (iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	if (iclsPtr2->flags & (ITCL_TYPE|ITCL_WIDGET|ITCL_WIDGETADAPTOR|
+		ITCL_ECLASS|ITCL_NWIDGET)) {
+	    flat = 0;
 	}
-	/* now initialize the variables which have an init value */
-	if (Itcl_PushCallFrame(interp, &frame, varNsPtr,
-		/*isProcCallFrame*/0) != TCL_OK) {
-	    goto errorCleanup2;
+    }
+    Itcl_DeleteHierIter(&hier);
+    if (flat) {
+	iclsPtr->flags |= ITCL_CLASS_FLAT_VARIABLES;
+	AddInitStep(iclsPtr, &size, ITCL_INIT_NAMESPACE, NULL, NULL);
+    }
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	if (!flat) {
+	    stepPtr = AddInitStep(iclsPtr, &size, ITCL_INIT_NAMESPACE,
+		    NULL, NULL);
+	    stepPtr->iclsPtr = iclsPtr2;
 	}
-	hPtr = Tcl_FirstHashEntry(&iclsPtr2->variables, &place);
-	while (hPtr) {
-	    ivPtr = (ItclVariable*)Tcl_GetHashValue(hPtr);
+	FOREACH_HASH_VALUE(ivPtr, &iclsPtr2->variables) {
 	    varName = Tcl_GetString(ivPtr->namePtr);
+	    namePtr = ivPtr->namePtr;
+	    if (flat && !(ivPtr->flags & ITCL_COMMON)) {
+		namePtr = FlatVarName(ivPtr);
+	    }
 	    if ((ivPtr->flags & ITCL_OPTIONS_VAR) && !itclOptionsIsSet) {
-		/* this is the special code for the "itcl_options" variable */
+		/*
+		 * The "itcl_options" variable is not created per object.
+		 */
 		itclOptionsIsSet = 1;
-		Tcl_DStringInit(&buffer2);
-		Tcl_DStringAppend(&buffer2, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-		Tcl_DStringAppend(&buffer,
-			(Tcl_GetObjectNamespace(ioPtr->oPtr))->fullName, TCL_INDEX_NONE);
-		varNsPtr2 = Tcl_FindNamespace(interp,
-			Tcl_DStringValue(&buffer2), NULL, 0);
-		if (varNsPtr2 == NULL) {
-		    varNsPtr2 = Tcl_CreateNamespace(interp,
-			    Tcl_DStringValue(&buffer2), NULL, 0);
-		}
-		Tcl_DStringFree(&buffer2);
-		Itcl_PopCallFrame(interp);
-		/* now initialize the variables which have an init value */
-		if (Itcl_PushCallFrame(interp, &frame, varNsPtr2,
-			/*isProcCallFrame*/0) != TCL_OK) {
-		    goto errorCleanup2;
-		}
-		Tcl_TraceVar2(interp, "itcl_options",
-			NULL,
-			TCL_TRACE_READS|TCL_TRACE_WRITES,
-			ItclTraceOptionVar, ioPtr);
-		Itcl_PopCallFrame(interp);
-		if (Itcl_PushCallFrame(interp, &frame, varNsPtr,
-			/*isProcCallFrame*/0) != TCL_OK) {
-		    goto errorCleanup2;
-		}
-		hPtr = Tcl_NextHashEntry(&place);
 		continue;
 	    }
 	    if (ivPtr->flags & ITCL_COMPONENT_VAR) {
@@ -840,7 +1190,7 @@ ItclInitObjectVariables(
 		    Tcl_AppendResult(interp, "cannot find component \"",
 			    Tcl_GetString(ivPtr->namePtr), "\" in class \"",
 			    Tcl_GetString(ivPtr->iclsPtr->namePtr), (char *)NULL);
-		    goto errorCleanup;
+		    goto errorReturn;
 		}
 		icPtr = (ItclComponent *)Tcl_GetHashValue(hPtr2);
 		if (icPtr->flags & ITCL_COMPONENT_INHERIT) {
@@ -852,206 +1202,436 @@ ItclInitObjectVariables(
 				inheritComponentName,
 				"\" now component \"",
 				Tcl_GetString(icPtr->namePtr), "\"", (char *)NULL);
-			goto errorCleanup;
-
-		    } else {
-			inheritComponentName = Tcl_GetString(icPtr->namePtr);
+			goto errorReturn;
 		    }
-		}
-		hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectComponents,
-			(char *)ivPtr->namePtr, &isNew);
-		if (isNew) {
-		    Tcl_SetHashValue(hPtr2, icPtr);
+		    inheritComponentName = Tcl_GetString(icPtr->namePtr);
 		}
 		/* this is a component variable */
 		/* FIXME initialize it to the empty string */
 		/* the initialization  is arguable, should it be done? */
-		if (Tcl_SetVar2(interp, varName, NULL,
-			"", TCL_NAMESPACE_ONLY) == NULL) {
-		    Tcl_AppendResult(interp, "INTERNAL ERROR cannot set",
-			    " variable \"", varName, "\"\n", (char *)NULL);
-		    goto errorCleanup;
-		}
+		stepPtr = AddInitStep(iclsPtr, &size, ITCL_INIT_COMPONENT, ivPtr,
+			namePtr);
+		stepPtr->icPtr = icPtr;
 	    }
-	    hPtr2 = ItclResolveVarEntry(ivPtr->iclsPtr, varName);
-	    if (hPtr2 == NULL) {
-		hPtr = Tcl_NextHashEntry(&place);
+	    if (ItclResolveVarEntry(ivPtr->iclsPtr, varName) == NULL) {
 		continue;
 	    }
 	    if ((ivPtr->flags & ITCL_COMMON) == 0) {
-		varPtr = Tcl_NewNamespaceVar(interp, varNsPtr,
-			Tcl_GetString(ivPtr->namePtr));
-		hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectVariables,
-			(char *)ivPtr, &isNew);
-		if (isNew) {
-		    Itcl_PreserveVar(varPtr);
-		    Tcl_SetHashValue(hPtr2, varPtr);
+		stepPtr = AddInitStep(iclsPtr, &size, ITCL_INIT_VARIABLE, ivPtr,
+			namePtr);
+		hPtr2 = Tcl_FindHashEntry(&iclsPtr->varSlotTable, (char *)ivPtr);
+		if (hPtr2 != NULL) {
+		    stepPtr->slotIndex = PTR2INT(Tcl_GetHashValue(hPtr2));
+		}
+		if ((iclsPtr2 == iclsPtr)
+			&& (ItclVarSpecialKind(ivPtr) == ITCL_VAR_KIND_THIS)) {
+		    /* all class scopes resolve "this" to this one */
+		    AddInitStep(iclsPtr, &size, ITCL_INIT_THIS, ivPtr, NULL);
 		}
 		if (ivPtr->flags & (ITCL_THIS_VAR|ITCL_TYPE_VAR|
 			ITCL_SELF_VAR|ITCL_SELFNS_VAR|ITCL_WIN_VAR)) {
-		    int isDone = 0;
-		    if (Tcl_SetVar2(interp, varName, NULL,
-			"", TCL_NAMESPACE_ONLY) == NULL) {
-			Tcl_AppendResult(interp, "INTERNAL ERROR cannot set",
-				" variable \"", varNsPtr->fullName, "::",
-				varName, "\"\n", (char *)NULL);
-			goto errorCleanup;
-		    }
-		if (ivPtr->flags & ITCL_THIS_VAR) {
-		    Tcl_TraceVar2(interp, varName, NULL,
-			TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceThisVar,
-			ioPtr);
-		    isDone = 1;
-		}
-		if (!isDone && ivPtr->flags & ITCL_TYPE_VAR) {
-		    Tcl_TraceVar2(interp, varName, NULL,
-			TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceTypeVar,
-			ioPtr);
-		    isDone = 1;
-		}
-		if (!isDone && ivPtr->flags & ITCL_SELF_VAR) {
-		    Tcl_TraceVar2(interp, varName, NULL,
-			TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceSelfVar,
-			ioPtr);
-		    isDone = 1;
-		}
-		if (!isDone && ivPtr->flags & ITCL_SELFNS_VAR) {
-		    Tcl_TraceVar2(interp, varName, NULL,
-			TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceSelfnsVar,
-			ioPtr);
-		    isDone = 1;
-		}
-		if (!isDone && ivPtr->flags & ITCL_WIN_VAR) {
-		    Tcl_TraceVar2(interp, varName, NULL,
-			TCL_TRACE_READS|TCL_TRACE_WRITES, ItclTraceWinVar,
-			ioPtr);
-		    isDone = 1;
-		}
-		} else {
-		    if (ivPtr->flags & ITCL_HULL_VAR) {
-			Tcl_TraceVar2(interp, varName, NULL,
-			    TCL_TRACE_READS|TCL_TRACE_WRITES,
-			    ItclTraceItclHullVar,
-			    ioPtr);
+		    if (ivPtr->flags & ITCL_THIS_VAR) {
+			traceProc = ItclTraceThisVar;
+		    } else if (ivPtr->flags & ITCL_TYPE_VAR) {
+			traceProc = ItclTraceTypeVar;
+		    } else if (ivPtr->flags & ITCL_SELF_VAR) {
+			traceProc = ItclTraceSelfVar;
+		    } else if (ivPtr->flags & ITCL_SELFNS_VAR) {
+			traceProc = ItclTraceSelfnsVar;
 		    } else {
-		      if (ivPtr->init != NULL) {
-			if (Tcl_SetVar2(interp,
-				Tcl_GetString(ivPtr->namePtr), NULL,
-				Tcl_GetString(ivPtr->init),
-				TCL_NAMESPACE_ONLY) == NULL) {
-			    goto errorCleanup;
-			}
-		      }
-		      if (ivPtr->arrayInitPtr != NULL) {
-			Tcl_DString buffer3;
-			Tcl_Size i;
-			Tcl_Size argc;
-			const char **argv;
-			const char *val;
-
-			Tcl_DStringInit(&buffer3);
-			Tcl_DStringAppend(&buffer3, varNsPtr->fullName, TCL_INDEX_NONE);
-			Tcl_DStringAppend(&buffer3, "::", TCL_INDEX_NONE);
-			Tcl_DStringAppend(&buffer3,
-				Tcl_GetString(ivPtr->namePtr), TCL_INDEX_NONE);
-			Tcl_SplitList(interp,
-				Tcl_GetString(ivPtr->arrayInitPtr),
-				&argc, &argv);
-			for (i = 0; i < argc; i += 2) {
-			    val = Tcl_SetVar2(interp,
-				    Tcl_DStringValue(&buffer3), argv[i],
-				    argv[i + 1], TCL_NAMESPACE_ONLY);
-			    if (!val) {
-				Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
-				    "cannot initialize variable \"",
-				    Tcl_GetString(ivPtr->namePtr), "\"",
-				    (char *)NULL);
-				return TCL_ERROR;
-			    }
-			}
-			Tcl_DStringFree(&buffer3);
-			Tcl_Free(argv);
-			}
-		      }
+			traceProc = ItclTraceWinVar;
 		    }
-		} else {
-		    if (ivPtr->flags & ITCL_HULL_VAR) {
-			Tcl_TraceVar2(interp, varName, NULL,
-			    TCL_TRACE_READS|TCL_TRACE_WRITES,
-			    ItclTraceItclHullVar,
-			    ioPtr);
+		    /*
+		     * The values only change when the object is renamed,
+		     * see UpdateBuiltinVars, so only writes are traced.
+		     * "self" of a widget follows its hull, though.
+		     */
+		    traceFlags = TCL_TRACE_WRITES;
+		    if ((traceProc == ItclTraceSelfVar) && (iclsPtr->flags
+			    & (ITCL_WIDGET|ITCL_WIDGETADAPTOR))) {
+			traceFlags |= TCL_TRACE_READS;
 		    }
-		    hPtr2 = Tcl_FindHashEntry(&iclsPtr2->classCommons,
-			    (char *)ivPtr);
-		    if (hPtr2 == NULL) {
-			goto errorCleanup;
+		    AddInitStep(iclsPtr, &size, ITCL_INIT_BUILTIN, ivPtr,
+			    namePtr);
+		    AddInitTrace(iclsPtr, &size, ivPtr, namePtr, traceFlags,
+			    traceProc);
+		} else if (ivPtr->flags & ITCL_HULL_VAR) {
+		    AddInitTrace(iclsPtr, &size, ivPtr, namePtr,
+			    TCL_TRACE_READS|TCL_TRACE_WRITES,
+			    ItclTraceItclHullVar);
+		} else {
+		    AddInitStep(iclsPtr, &size, ITCL_INIT_VALUE, ivPtr, namePtr);
+		    if (ivPtr->flags & ITCL_COMPONENT_VAR) {
+			/* keeps the delegation plans of the object current */
+			AddInitTrace(iclsPtr, &size, ivPtr, namePtr,
+				TCL_TRACE_WRITES, ItclTraceComponentVar);
 		    }
-		    varPtr = (Tcl_Var)Tcl_GetHashValue(hPtr2);
-		    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectVariables,
-			    (char *)ivPtr, &isNew);
-		    if (isNew) {
-			Itcl_PreserveVar(varPtr);
-			Tcl_SetHashValue(hPtr2, varPtr);
 		}
+	    } else {
+		if (ivPtr->flags & ITCL_HULL_VAR) {
+		    AddInitTrace(iclsPtr, &size, ivPtr, ivPtr->namePtr,
+			    TCL_TRACE_READS|TCL_TRACE_WRITES,
+			    ItclTraceItclHullVar);
+		}
+		hPtr2 = Tcl_FindHashEntry(&iclsPtr2->classCommons,
+			(char *)ivPtr);
+		if (hPtr2 == NULL) {
+		    goto errorReturn;
+		}
+		stepPtr = AddInitStep(iclsPtr, &size, ITCL_INIT_COMMON, ivPtr,
+			NULL);
+		stepPtr->varPtr = (Tcl_Var)Tcl_GetHashValue(hPtr2);
 		if (ivPtr->flags & ITCL_COMPONENT_VAR) {
-		    if (ivPtr->flags & ITCL_COMMON) {
-			Tcl_Obj *objPtr2;
-			objPtr2 = Tcl_NewStringObj(ITCL_VARIABLES_NAMESPACE,
-				TCL_INDEX_NONE);
-			Tcl_AppendToObj(objPtr2, (Tcl_GetObjectNamespace(
-				ivPtr->iclsPtr->oPtr))->fullName, TCL_INDEX_NONE);
-			Tcl_AppendToObj(objPtr2, "::", TCL_INDEX_NONE);
-			Tcl_AppendToObj(objPtr2, varName, TCL_INDEX_NONE);
-			/* itcl_hull is traced in itclParse.c */
-			if (strcmp(varName, "itcl_hull") == 0) {
-			    Tcl_TraceVar2(interp,
-				    Tcl_GetString(objPtr2), NULL,
-				    TCL_TRACE_WRITES, ItclTraceItclHullVar,
-				    ioPtr);
-			} else {
-			    Tcl_TraceVar2(interp,
-				    Tcl_GetString(objPtr2), NULL,
-				    TCL_TRACE_WRITES, ItclTraceComponentVar,
-				    ioPtr);
-			}
-			Tcl_DecrRefCount(objPtr2);
-		    } else {
-			Tcl_TraceVar2(interp,
-				varName, NULL,
-				TCL_TRACE_WRITES, ItclTraceComponentVar,
-				ioPtr);
-		    }
+		    objPtr = Tcl_NewStringObj(ITCL_VARIABLES_NAMESPACE,
+			    TCL_INDEX_NONE);
+		    Tcl_AppendToObj(objPtr, (Tcl_GetObjectNamespace(
+			    ivPtr->iclsPtr->oPtr))->fullName, TCL_INDEX_NONE);
+		    Tcl_AppendToObj(objPtr, "::", TCL_INDEX_NONE);
+		    Tcl_AppendToObj(objPtr, varName, TCL_INDEX_NONE);
+		    /* itcl_hull is traced in itclParse.c */
+		    AddInitTrace(iclsPtr, &size, ivPtr, objPtr, TCL_TRACE_WRITES,
+			    (strcmp(varName, "itcl_hull") == 0) ?
+			    ItclTraceItclHullVar : ItclTraceComponentVar);
 		}
 	    }
-	    hPtr = Tcl_NextHashEntry(&place);
 	}
-	Itcl_PopCallFrame(interp);
-	iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
-    Tcl_DStringFree(&buffer);
     Itcl_DeleteHierIter(&hier);
     return TCL_OK;
-errorCleanup:
-    Itcl_PopCallFrame(interp);
-errorCleanup2:
-    varNsPtr = Tcl_FindNamespace(interp, Tcl_GetString(ioPtr->varNsNamePtr),
-	    NULL, 0);
-    if (varNsPtr != NULL) {
-	Tcl_DeleteNamespace(varNsPtr);
-    }
+
+errorReturn:
+    Itcl_DeleteHierIter(&hier);
+    ItclFreeInitPlan(iclsPtr);
+    iclsPtr->flags &= ~ITCL_CLASS_FLAT_VARIABLES;
     return TCL_ERROR;
 }
-
+
 /*
  * ------------------------------------------------------------------------
- *  ItclInitObjectOptions()
+ *  ItclFreeInitPlan()
  *
- *  Collect all instance options for the given object instance to allow
- *  faster runtime access to the options.
- *  if the same option name is used in more than one class the first one
- *  found is used (for initializing and for the class name)!!
- *  # It is assumed, that an option can only exist in one class??
- *  # So no duplicates allowed??
+ *  Releases the object initialization plan of a class.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeInitPlan(
+    ItclClass *iclsPtr)
+{
+    Tcl_Size i;
+
+    for (i = 0; i < iclsPtr->numInitSteps; i++) {
+	if (iclsPtr->initPlan[i].namePtr != NULL) {
+	    Tcl_DecrRefCount(iclsPtr->initPlan[i].namePtr);
+	}
+    }
+    if (iclsPtr->initPlan != NULL) {
+	Tcl_Free(iclsPtr->initPlan);
+    }
+    iclsPtr->initPlan = NULL;
+    iclsPtr->numInitSteps = 0;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclBuildLifecyclePlan()
+ *
+ *  Records which classes of the hierarchy of "iclsPtr" take part in
+ *  constructing and destructing its objects.  Objects of a hierarchy
+ *  without constructors skip the construction bookkeeping altogether,
+ *  and destruction only visits the classes listed in destructPlan, in
+ *  hierarchy order from most- to least-specific.  Like the init plan,
+ *  this is done when the first object of the class is created.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclBuildLifecyclePlan(
+    ItclClass *iclsPtr)
+{
+    ItclHierIter hier;
+    ItclClass *iclsPtr2;
+    Tcl_Obj *ctorPtr;
+    Tcl_Obj *dtorPtr;
+    Tcl_Size size;
+
+    ItclFreeLifecyclePlan(iclsPtr);
+    ctorPtr = Tcl_NewStringObj("constructor", TCL_INDEX_NONE);
+    Tcl_IncrRefCount(ctorPtr);
+    dtorPtr = Tcl_NewStringObj("destructor", TCL_INDEX_NONE);
+    Tcl_IncrRefCount(dtorPtr);
+    size = 0;
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	if ((iclsPtr2->initCode != NULL)
+		|| (Tcl_FindHashEntry(&iclsPtr2->functions,
+		(char *)ctorPtr) != NULL)) {
+	    iclsPtr->numConstructors++;
+	}
+	if (Tcl_FindHashEntry(&iclsPtr2->functions, (char *)dtorPtr) != NULL) {
+	    if (iclsPtr->numDestructors >= size) {
+		size = (size == 0) ? 4 : 2 * size;
+		iclsPtr->destructPlan = (ItclClass **)Tcl_Realloc(
+			iclsPtr->destructPlan, size * sizeof(ItclClass *));
+	    }
+	    iclsPtr->destructPlan[iclsPtr->numDestructors++] = iclsPtr2;
+	}
+    }
+    Itcl_DeleteHierIter(&hier);
+    Tcl_DecrRefCount(ctorPtr);
+    Tcl_DecrRefCount(dtorPtr);
+    iclsPtr->flags |= ITCL_CLASS_LIFECYCLE_PLAN;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeLifecyclePlan()
+ *
+ *  Releases what ItclBuildLifecyclePlan() recorded for a class.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeLifecyclePlan(
+    ItclClass *iclsPtr)
+{
+    if (iclsPtr->destructPlan != NULL) {
+	Tcl_Free(iclsPtr->destructPlan);
+    }
+    iclsPtr->destructPlan = NULL;
+    iclsPtr->numDestructors = 0;
+    iclsPtr->numConstructors = 0;
+    iclsPtr->flags &= ~ITCL_CLASS_LIFECYCLE_PLAN;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclResetObjectPlans()
+ *
+ *  Forgets the variable slots, the init plan and the lifecycle plan of
+ *  a class and of all classes derived from it.  Called whenever the
+ *  variables, methods or base classes of a class change; the next
+ *  object of the class builds them again.  Objects that already exist
+ *  keep their varSlots, which ItclGetObjectVarSlot() no longer uses
+ *  once the layout of the class has changed.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclResetObjectPlans(
+    ItclClass *iclsPtr)
+{
+    Itcl_ListElem *elem;
+
+    if (iclsPtr->varSlotsId != 0) {
+	Tcl_DeleteHashTable(&iclsPtr->varSlotTable);
+	Tcl_InitHashTable(&iclsPtr->varSlotTable, TCL_ONE_WORD_KEYS);
+	if (iclsPtr->slotVars != NULL) {
+	    Tcl_Free(iclsPtr->slotVars);
+	    iclsPtr->slotVars = NULL;
+	}
+	iclsPtr->numVarSlots = 0;
+	iclsPtr->varSlotsId = 0;
+    }
+    ItclFreeInitPlan(iclsPtr);
+    ItclFreeLifecyclePlan(iclsPtr);
+    elem = Itcl_FirstListElem(&iclsPtr->derived);
+    while (elem) {
+	ItclResetObjectPlans((ItclClass *)Itcl_GetListValue(elem));
+	elem = Itcl_NextListElem(elem);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInitObjectVariables()
+ *
+ *  Init all instance variables and create the necessary variable namespaces
+ *  for the given object instance.  This is usually invoked automatically
+ *  by Itcl_CreateObject(), when an object is created.  The work is done
+ *  by replaying the initialization plan of the class, see
+ *  ItclBuildInitPlan().
+ * ------------------------------------------------------------------------
+ */
+static int
+ItclInitObjectVariables(
+   Tcl_Interp *interp,
+   ItclObject *ioPtr,
+   ItclClass *iclsPtr)
+{
+    Tcl_DString buffer;
+    Tcl_HashEntry *hPtr;
+    Tcl_Namespace *varNsPtr;
+    Tcl_CallFrame frame;
+    Tcl_Var varPtr;
+    Tcl_Obj **objv;
+    ItclInitStep *stepPtr;
+    ItclInitStep *endPtr;
+    ItclVariable *ivPtr;
+    Tcl_Size prefixLength;
+    Tcl_Size objc;
+    Tcl_Size i;
+    int haveFrame;
+    int isNew;
+
+    ItclInitVarSlots(iclsPtr);
+    if ((ioPtr->varSlots == NULL) && (iclsPtr->numVarSlots > 0)) {
+	ioPtr->varSlotsId = iclsPtr->varSlotsId;
+	ioPtr->numVarSlots = iclsPtr->numVarSlots;
+	ioPtr->varSlots = (Tcl_Var *)Tcl_Alloc(
+		sizeof(Tcl_Var) * ioPtr->numVarSlots);
+	memset(ioPtr->varSlots, 0, sizeof(Tcl_Var) * ioPtr->numVarSlots);
+    }
+    Tcl_ResetResult(interp);
+    if ((iclsPtr->initPlan == NULL)
+	    && (ItclBuildInitPlan(interp, ioPtr, iclsPtr) != TCL_OK)) {
+	goto errorCleanup2;
+    }
+
+    /*
+     * create all the variables for each class in the
+     * ::itcl::variables::<object namespace>::<class> namespace as an
+     * undefined variable using the Tcl "variable xx" command
+     */
+    Tcl_DStringInit(&buffer);
+    Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
+    Tcl_DStringAppend(&buffer,
+	    (Tcl_GetObjectNamespace(ioPtr->oPtr))->fullName, TCL_INDEX_NONE);
+    prefixLength = Tcl_DStringLength(&buffer);
+    haveFrame = 0;
+    varNsPtr = NULL;
+    varPtr = NULL;
+    endPtr = iclsPtr->initPlan + iclsPtr->numInitSteps;
+    for (stepPtr = iclsPtr->initPlan; stepPtr < endPtr; stepPtr++) {
+	ivPtr = stepPtr->ivPtr;
+	switch (stepPtr->op) {
+	case ITCL_INIT_NAMESPACE:
+	    if (haveFrame) {
+		Itcl_PopCallFrame(interp);
+		haveFrame = 0;
+	    }
+	    Tcl_DStringSetLength(&buffer, prefixLength);
+	    if (stepPtr->iclsPtr != NULL) {
+		Tcl_DStringAppend(&buffer, stepPtr->iclsPtr->nsPtr->fullName,
+			TCL_INDEX_NONE);
+	    }
+	    varNsPtr = Tcl_FindNamespace(interp, Tcl_DStringValue(&buffer),
+		    NULL, 0);
+	    if (varNsPtr == NULL) {
+		varNsPtr = Tcl_CreateNamespace(interp,
+			Tcl_DStringValue(&buffer), NULL, 0);
+	    }
+	    if (Itcl_PushCallFrame(interp, &frame, varNsPtr,
+		    /*isProcCallFrame*/0) != TCL_OK) {
+		Tcl_DStringFree(&buffer);
+		goto errorCleanup2;
+	    }
+	    haveFrame = 1;
+	    break;
+	case ITCL_INIT_COMPONENT:
+	    hPtr = Tcl_CreateHashEntry(&ItclGetObjectExt(ioPtr)->objectComponents,
+		    (char *)ivPtr->namePtr, &isNew);
+	    if (isNew) {
+		Tcl_SetHashValue(hPtr, stepPtr->icPtr);
+	    }
+	    if (Tcl_SetVar2(interp, Tcl_GetString(stepPtr->namePtr), NULL,
+		    "", TCL_NAMESPACE_ONLY) == NULL) {
+		Tcl_AppendResult(interp, "INTERNAL ERROR cannot set",
+			" variable \"", Tcl_GetString(ivPtr->namePtr), "\"\n",
+			(char *)NULL);
+		goto errorCleanup;
+	    }
+	    break;
+	case ITCL_INIT_VARIABLE:
+	    varPtr = Tcl_NewNamespaceVar(interp, varNsPtr,
+		    Tcl_GetString(stepPtr->namePtr));
+	    hPtr = Tcl_CreateHashEntry(&ioPtr->objectVariables,
+		    (char *)ivPtr, &isNew);
+	    if (isNew) {
+		Itcl_PreserveVar(varPtr);
+		Tcl_SetHashValue(hPtr, varPtr);
+		if ((stepPtr->slotIndex >= 0) && (ioPtr->varSlots != NULL)) {
+		    ioPtr->varSlots[stepPtr->slotIndex] = varPtr;
+		}
+	    }
+	    break;
+	case ITCL_INIT_THIS:
+	    if (ioPtr->thisVarPtr == NULL) {
+		ioPtr->thisVarPtr = varPtr;
+	    }
+	    break;
+	case ITCL_INIT_COMMON:
+	    hPtr = Tcl_CreateHashEntry(&ioPtr->objectVariables,
+		    (char *)ivPtr, &isNew);
+	    if (isNew) {
+		Itcl_PreserveVar(stepPtr->varPtr);
+		Tcl_SetHashValue(hPtr, stepPtr->varPtr);
+	    }
+	    break;
+	case ITCL_INIT_BUILTIN:
+	    if (Tcl_ObjSetVar2(interp, stepPtr->namePtr, NULL,
+		    BuiltinVarValue(ioPtr, BuiltinVarKind(ivPtr)),
+		    TCL_NAMESPACE_ONLY) == NULL) {
+		Tcl_AppendResult(interp, "INTERNAL ERROR cannot set",
+			" variable \"", varNsPtr->fullName, "::",
+			Tcl_GetString(stepPtr->namePtr), "\"\n", (char *)NULL);
+		goto errorCleanup;
+	    }
+	    break;
+	case ITCL_INIT_VALUE:
+	    /* the initial values are shared with the class definition */
+	    if (ivPtr->init != NULL) {
+		if (Tcl_ObjSetVar2(interp, stepPtr->namePtr, NULL, ivPtr->init,
+			TCL_NAMESPACE_ONLY) == NULL) {
+		    goto errorCleanup;
+		}
+	    }
+	    if (ivPtr->arrayInitPtr != NULL) {
+		if (Tcl_ListObjGetElements(interp, ivPtr->arrayInitPtr,
+			&objc, &objv) != TCL_OK) {
+		    goto errorCleanup;
+		}
+		for (i = 0; i + 1 < objc; i += 2) {
+		    if (Tcl_ObjSetVar2(interp, stepPtr->namePtr, objv[i],
+			    objv[i + 1], TCL_NAMESPACE_ONLY) == NULL) {
+			Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
+				"cannot initialize variable \"",
+				Tcl_GetString(ivPtr->namePtr), "\"",
+				(char *)NULL);
+			goto errorCleanup;
+		    }
+		}
+	    }
+	    break;
+	case ITCL_INIT_TRACE:
+	    Tcl_TraceVar2(interp, Tcl_GetString(stepPtr->namePtr), NULL,
+		    stepPtr->traceFlags, stepPtr->traceProc, ioPtr);
+	    break;
+	}
+    }
+    if (haveFrame) {
+	Itcl_PopCallFrame(interp);
+    }
+    Tcl_DStringFree(&buffer);
+    return TCL_OK;
+errorCleanup:
+    Itcl_PopCallFrame(interp);
+    Tcl_DStringFree(&buffer);
+errorCleanup2:
+    varNsPtr = Tcl_FindNamespace(interp, Tcl_GetString(ioPtr->varNsNamePtr),
+	    NULL, 0);
+    if (varNsPtr != NULL) {
+	Tcl_DeleteNamespace(varNsPtr);
+    }
+    return TCL_ERROR;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclInitObjectOptions()
+ *
+ *  Collect all instance options for the given object instance to allow
+ *  faster runtime access to the options.
+ *  if the same option name is used in more than one class the first one
+ *  found is used (for initializing and for the class name)!!
+ *  # It is assumed, that an option can only exist in one class??
+ *  # So no duplicates allowed??
  *  This is usually invoked automatically by Itcl_CreateObject(),
  *  when an object is created.
  * ------------------------------------------------------------------------
@@ -1062,19 +1642,28 @@ ItclInitObjectOptions(
    ItclObject *ioPtr,
    ItclClass *iclsPtr)
 {
-    Tcl_DString buffer;
     Tcl_HashEntry *hPtr;
     Tcl_HashEntry *hPtr2;
     Tcl_HashSearch place;
-    Tcl_CallFrame frame;
-    Tcl_Namespace *varNsPtr;
+    Tcl_Obj *arrayNamePtr;
+    ItclObjectExt *extPtr;
     ItclClass *iclsPtr2;
     ItclHierIter hier;
     ItclOption *ioptPtr;
     ItclDelegatedOption *idoPtr;
+    int buildSlots;
     int isNew;
+    int result;
 
-    ioptPtr = NULL;
+    /*
+     *  The first object of a class numbers the options it collects, so
+     *  that the objects can keep their "itcl_options" elements in the
+     *  optionSlots array, see ItclGetOptionValue().
+     */
+    buildSlots = ((iclsPtr == ioPtr->iclsPtr)
+	    && !(iclsPtr->flags & ITCL_CLASS_OPTION_SLOTS));
+    arrayNamePtr = NULL;
+    result = TCL_OK;
     Itcl_InitHierIter(&hier, iclsPtr);
     iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     while (iclsPtr2 != NULL) {
@@ -1082,41 +1671,38 @@ ItclInitObjectOptions(
 	hPtr = Tcl_FirstHashEntry(&iclsPtr2->options, &place);
 	while (hPtr) {
 	    ioptPtr = (ItclOption*)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectOptions,
+	    hPtr2 = Tcl_CreateHashEntry(&ItclGetObjectExt(ioPtr)->objectOptions,
 		    (char *)ioptPtr->namePtr, &isNew);
 	    if (isNew) {
 		Tcl_SetHashValue(hPtr2, ioptPtr);
-		Tcl_DStringInit(&buffer);
-		Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-		Tcl_DStringAppend(&buffer,
-			(Tcl_GetObjectNamespace(ioPtr->oPtr)->fullName), TCL_INDEX_NONE);
-		varNsPtr = Tcl_FindNamespace(interp,
-			Tcl_DStringValue(&buffer), NULL, 0);
-		if (varNsPtr == NULL) {
-		    varNsPtr = Tcl_CreateNamespace(interp,
-			    Tcl_DStringValue(&buffer), NULL, 0);
-		}
-		Tcl_DStringFree(&buffer);
-		/* now initialize the options which have an init value */
-		if (Itcl_PushCallFrame(interp, &frame, varNsPtr,
-			/*isProcCallFrame*/0) != TCL_OK) {
-		    return TCL_ERROR;
+		if (buildSlots) {
+		    hPtr2 = Tcl_CreateHashEntry(&iclsPtr->optionSlotTable,
+			    (char *)ioptPtr, &isNew);
+		    if (isNew) {
+			Tcl_SetHashValue(hPtr2,
+				INT2PTR(iclsPtr->numOptionSlots));
+			iclsPtr->numOptionSlots++;
+		    }
 		}
-		if ((ioptPtr != NULL) && (ioptPtr->namePtr != NULL) &&
-			(ioptPtr->defaultValuePtr != NULL)) {
-		    if (Tcl_SetVar2(interp, "itcl_options",
-			    Tcl_GetString(ioptPtr->namePtr),
-			    Tcl_GetString(ioptPtr->defaultValuePtr),
-			    TCL_NAMESPACE_ONLY) == NULL) {
-			Itcl_PopCallFrame(interp);
-			return TCL_ERROR;
+		if (ioptPtr->defaultValuePtr != NULL) {
+		    if (arrayNamePtr == NULL) {
+			if (Tcl_FindNamespace(interp,
+				Tcl_GetString(ioPtr->varNsNamePtr),
+				NULL, 0) == NULL) {
+			    Tcl_CreateNamespace(interp,
+				    Tcl_GetString(ioPtr->varNsNamePtr),
+				    NULL, 0);
+			}
+			arrayNamePtr = Tcl_ObjPrintf("%s::itcl_options",
+				Tcl_GetString(ioPtr->varNsNamePtr));
+			Tcl_IncrRefCount(arrayNamePtr);
+		    }
+		    if (Tcl_ObjSetVar2(interp, arrayNamePtr, ioptPtr->namePtr,
+			    ioptPtr->defaultValuePtr, TCL_GLOBAL_ONLY) == NULL) {
+			result = TCL_ERROR;
+			goto done;
 		    }
-		    Tcl_TraceVar2(interp, "itcl_options",
-			    NULL,
-			    TCL_TRACE_READS|TCL_TRACE_WRITES,
-			    ItclTraceOptionVar, ioPtr);
 		}
-		Itcl_PopCallFrame(interp);
 	    }
 	    hPtr = Tcl_NextHashEntry(&place);
 	}
@@ -1124,7 +1710,7 @@ ItclInitObjectOptions(
 	hPtr = Tcl_FirstHashEntry(&iclsPtr2->delegatedOptions, &place);
 	while (hPtr) {
 	    idoPtr = (ItclDelegatedOption*)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectDelegatedOptions,
+	    hPtr2 = Tcl_CreateHashEntry(&ItclGetObjectExt(ioPtr)->objectDelegatedOptions,
 		    (char *)idoPtr->namePtr, &isNew);
 	    if (isNew) {
 		Tcl_SetHashValue(hPtr2, idoPtr);
@@ -1133,10 +1719,293 @@ ItclInitObjectOptions(
 	}
 	iclsPtr2 = Itcl_AdvanceHierIter(&hier);
     }
+    if (buildSlots) {
+	iclsPtr->flags |= ITCL_CLASS_OPTION_SLOTS;
+	ItclFreeOptionDispatch(iclsPtr);
+    }
+    if ((iclsPtr == ioPtr->iclsPtr)
+	    && !(ioPtr->flags & ITCL_OBJECT_OWN_OPTIONS)) {
+	ioPtr->flags |= ITCL_OBJECT_CLASS_OPTIONS;
+    }
+    extPtr = ioPtr->extPtr;
+    if ((extPtr != NULL) && (extPtr->optionSlots == NULL)
+	    && (ioPtr->iclsPtr->numOptionSlots > 0)) {
+	extPtr->numOptionSlots = ioPtr->iclsPtr->numOptionSlots;
+	extPtr->optionSlots = (Tcl_Var *)Tcl_Alloc(
+		sizeof(Tcl_Var) * extPtr->numOptionSlots);
+	memset(extPtr->optionSlots, 0,
+		sizeof(Tcl_Var) * extPtr->numOptionSlots);
+    }
+done:
     Itcl_DeleteHierIter(&hier);
+    if (arrayNamePtr != NULL) {
+	Tcl_DecrRefCount(arrayNamePtr);
+    }
+    return result;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  OptionElementVar()
+ *
+ *  Returns the "itcl_options" element of option ioptPtr of an object
+ *  from its optionSlots, looking it up and preserving it on first use.
+ *  "idx" is the slot of the option if the caller knows it, or -1.
+ *  Returns NULL if the option has no slot or the element doesn't exist;
+ *  "arrayVarPtr" is set to the "itcl_options" array otherwise.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Var
+OptionElementVar(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclOption *ioptPtr,
+    Tcl_Size idx,
+    Tcl_Var *arrayVarPtr)
+{
+    Tcl_HashEntry *hPtr;
+    ItclObjectExt *extPtr;
+    Tcl_Var *slotPtr;
+    Tcl_Var arrayVar;
+
+    extPtr = ioPtr->extPtr;
+    if ((extPtr == NULL) || (extPtr->optionSlots == NULL)) {
+	return NULL;
+    }
+    if (idx < 0) {
+	hPtr = Tcl_FindHashEntry(&ioPtr->iclsPtr->optionSlotTable,
+		(char *)ioptPtr);
+	if (hPtr == NULL) {
+	    return NULL;
+	}
+	idx = PTR2INT(Tcl_GetHashValue(hPtr));
+    }
+    if (idx >= extPtr->numOptionSlots) {
+	return NULL;
+    }
+    arrayVar = ItclObjectSpecialVar(interp, ioPtr, ITCL_VAR_KIND_OPTIONS);
+    if (arrayVar == NULL) {
+	return NULL;
+    }
+    slotPtr = &extPtr->optionSlots[idx];
+    if ((*slotPtr != NULL) && !Itcl_IsVarDefined(*slotPtr)) {
+	/* unset by a script, maybe together with the whole array */
+	Itcl_ReleaseVar(*slotPtr);
+	*slotPtr = NULL;
+    }
+    if (*slotPtr == NULL) {
+	*slotPtr = Itcl_FindArrayElement(arrayVar, ioptPtr->namePtr);
+	if (*slotPtr == NULL) {
+	    return NULL;
+	}
+	Itcl_PreserveVar(*slotPtr);
+    }
+    *arrayVarPtr = arrayVar;
+    return *slotPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetOptionValue()
+ *
+ *  Returns the value of option ioptPtr of an object, or NULL if its
+ *  "itcl_options" element is not set.  Untraced elements are read
+ *  straight from the optionSlots of the object; anything else goes
+ *  through the usual variable lookup.  "slotIndex" is the slot from
+ *  the ItclOptionDispatch entry of the option, or -1.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Obj *
+ItclGetOptionValue(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclOption *ioptPtr,
+    Tcl_Size slotIndex)
+{
+    Tcl_Var arrayVar;
+    Tcl_Var varPtr;
+    Tcl_Obj *valuePtr;
+    const char *val;
+
+    varPtr = OptionElementVar(interp, ioPtr, ioptPtr, slotIndex, &arrayVar);
+    if (varPtr != NULL) {
+	valuePtr = Itcl_GetPlainElement(arrayVar, varPtr);
+	if (valuePtr != NULL) {
+	    return valuePtr;
+	}
+    }
+    val = ItclGetInstanceVar(interp, "itcl_options",
+	    Tcl_GetString(ioptPtr->namePtr), ioPtr, ioptPtr->iclsPtr);
+    if (val == NULL) {
+	return NULL;
+    }
+    return Tcl_NewStringObj(val, TCL_INDEX_NONE);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclSetOptionValue()
+ *
+ *  Stores a new value for option ioptPtr of an object, the counterpart
+ *  of ItclGetOptionValue().  Returns TCL_ERROR with a message in the
+ *  interpreter if the variable cannot be set.
+ * ------------------------------------------------------------------------
+ */
+int
+ItclSetOptionValue(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclOption *ioptPtr,
+    Tcl_Size slotIndex,
+    Tcl_Obj *valuePtr)
+{
+    Tcl_Var arrayVar;
+    Tcl_Var varPtr;
+
+    varPtr = OptionElementVar(interp, ioPtr, ioptPtr, slotIndex, &arrayVar);
+    if ((varPtr != NULL) && Itcl_SetPlainElement(arrayVar, varPtr, valuePtr)) {
+	return TCL_OK;
+    }
+    if (ItclSetInstanceVar(interp, "itcl_options",
+	    Tcl_GetString(ioptPtr->namePtr), Tcl_GetString(valuePtr),
+	    ioPtr, ioptPtr->iclsPtr) == NULL) {
+	return TCL_ERROR;
+    }
     return TCL_OK;
 }
-
+
+/*
+ * ------------------------------------------------------------------------
+ *  AddOptionDispatch()
+ *
+ *  Returns the entry for "namePtr" in the option dispatch table of a
+ *  class, creating an empty one if needed.
+ * ------------------------------------------------------------------------
+ */
+static ItclOptionDispatch *
+AddOptionDispatch(
+    ItclClass *iclsPtr,
+    Tcl_Obj *namePtr)
+{
+    Tcl_HashEntry *hPtr;
+    ItclOptionDispatch *dispatchPtr;
+    int isNew;
+
+    hPtr = Tcl_CreateHashEntry(&iclsPtr->optionDispatch, (char *)namePtr,
+	    &isNew);
+    if (isNew) {
+	dispatchPtr = (ItclOptionDispatch *)Tcl_Alloc(
+		sizeof(ItclOptionDispatch));
+	dispatchPtr->ioptPtr = NULL;
+	dispatchPtr->idoPtr = NULL;
+	dispatchPtr->slotIndex = -1;
+	Tcl_SetHashValue(hPtr, dispatchPtr);
+    }
+    return (ItclOptionDispatch *)Tcl_GetHashValue(hPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclBuildOptionDispatch()
+ *
+ *  Collects once per class what "configure" and "cget" look up on every
+ *  call: for each option name the option and the delegated option that
+ *  ItclInitObjectOptions() puts in the tables of an object of the class,
+ *  together with the slot of the option, the "delegate option *" entry,
+ *  and whether "delegate method *" of the class covers "configure" and
+ *  "cget".  The class definition is complete by the time the first
+ *  object exists, so the table stays valid until the class is freed.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclBuildOptionDispatch(
+    ItclClass *iclsPtr)
+{
+    FOREACH_HASH_DECLS;
+    Tcl_HashEntry *hPtr2;
+    Tcl_Obj *namePtr;
+    ItclClass *iclsPtr2;
+    ItclHierIter hier;
+    ItclOption *ioptPtr;
+    ItclDelegatedOption *idoPtr;
+    ItclDelegatedFunction *idmPtr;
+    ItclOptionDispatch *dispatchPtr;
+
+    if (iclsPtr->flags & ITCL_CLASS_OPTION_DISPATCH) {
+	return;
+    }
+    Itcl_InitHierIter(&hier, iclsPtr);
+    while ((iclsPtr2 = Itcl_AdvanceHierIter(&hier)) != NULL) {
+	FOREACH_HASH_VALUE(ioptPtr, &iclsPtr2->options) {
+	    dispatchPtr = AddOptionDispatch(iclsPtr, ioptPtr->namePtr);
+	    if (dispatchPtr->ioptPtr != NULL) {
+		continue;
+	    }
+	    dispatchPtr->ioptPtr = ioptPtr;
+	    if (iclsPtr->flags & ITCL_CLASS_OPTION_SLOTS) {
+		hPtr2 = Tcl_FindHashEntry(&iclsPtr->optionSlotTable,
+			(char *)ioptPtr);
+		if (hPtr2 != NULL) {
+		    dispatchPtr->slotIndex = PTR2INT(Tcl_GetHashValue(hPtr2));
+		}
+	    }
+	}
+	FOREACH_HASH_VALUE(idoPtr, &iclsPtr2->delegatedOptions) {
+	    dispatchPtr = AddOptionDispatch(iclsPtr, idoPtr->namePtr);
+	    if (dispatchPtr->idoPtr != NULL) {
+		continue;
+	    }
+	    dispatchPtr->idoPtr = idoPtr;
+	    if (strcmp(Tcl_GetString(idoPtr->namePtr), "*") == 0) {
+		iclsPtr->allOptionsPtr = idoPtr;
+	    }
+	}
+    }
+    Itcl_DeleteHierIter(&hier);
+
+    namePtr = Tcl_NewStringObj("*", 1);
+    Tcl_IncrRefCount(namePtr);
+    hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions, (char *)namePtr);
+    if (hPtr != NULL) {
+	idmPtr = (ItclDelegatedFunction *)Tcl_GetHashValue(hPtr);
+	Tcl_SetStringObj(namePtr, "configure", TCL_INDEX_NONE);
+	if (Tcl_FindHashEntry(&idmPtr->exceptions, (char *)namePtr) == NULL) {
+	    iclsPtr->configureIdmPtr = idmPtr;
+	}
+	Tcl_SetStringObj(namePtr, "cget", TCL_INDEX_NONE);
+	if (Tcl_FindHashEntry(&idmPtr->exceptions, (char *)namePtr) == NULL) {
+	    iclsPtr->cgetIdmPtr = idmPtr;
+	}
+    }
+    Tcl_DecrRefCount(namePtr);
+    iclsPtr->flags |= ITCL_CLASS_OPTION_DISPATCH;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeOptionDispatch()
+ *
+ *  Frees the entries built by ItclBuildOptionDispatch().
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeOptionDispatch(
+    ItclClass *iclsPtr)
+{
+    FOREACH_HASH_DECLS;
+    ItclOptionDispatch *dispatchPtr;
+
+    FOREACH_HASH_VALUE(dispatchPtr, &iclsPtr->optionDispatch) {
+	Tcl_Free(dispatchPtr);
+    }
+    Tcl_DeleteHashTable(&iclsPtr->optionDispatch);
+    Tcl_InitObjHashTable(&iclsPtr->optionDispatch);
+    iclsPtr->allOptionsPtr = NULL;
+    iclsPtr->configureIdmPtr = NULL;
+    iclsPtr->cgetIdmPtr = NULL;
+    iclsPtr->flags &= ~ITCL_CLASS_OPTION_DISPATCH;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclInitObjectMethodVariables()
@@ -1169,7 +2038,7 @@ ItclInitObjectMethodVariables(
 	hPtr = Tcl_FirstHashEntry(&iclsPtr2->methodVariables, &place);
 	while (hPtr) {
 	    imvPtr = (ItclMethodVariable*)Tcl_GetHashValue(hPtr);
-	    hPtr2 = Tcl_CreateHashEntry(&ioPtr->objectMethodVariables,
+	    hPtr2 = Tcl_CreateHashEntry(&ItclGetObjectExt(ioPtr)->objectMethodVariables,
 		    (char *)imvPtr->namePtr, &isNew);
 	    if (isNew) {
 		Tcl_SetHashValue(hPtr2, imvPtr);
@@ -1226,6 +2095,7 @@ Itcl_DeleteObject(
     if (hPtr) {
 	Tcl_DeleteHashEntry(hPtr);
     }
+    RemoveObjectInstance(contextIoPtr);
 
     /*
      *  Change the object's access command so that it can be
@@ -1244,6 +2114,10 @@ Itcl_DeleteObject(
     }
     contextIoPtr->oPtr = NULL;
     contextIoPtr->accessCmd = NULL;
+    if (contextIoPtr->flags & ITCL_OBJECT_SHOULD_VARNS_DELETE) {
+	/* still in use, so "this" must read as deleted */
+	UpdateBuiltinVars(contextIoPtr, ITCL_THIS_VAR|ITCL_SELF_VAR);
+    }
 
     Itcl_ReleaseData(contextIoPtr);
 
@@ -1288,9 +2162,6 @@ FinalizeDeleteObject(
 	Tcl_ResetResult(interp);
     }
 
-    Tcl_DeleteHashTable(contextIoPtr->destructed);
-    Tcl_Free(contextIoPtr->destructed);
-    contextIoPtr->destructed = NULL;
     return result;
 }
 
@@ -1307,8 +2178,7 @@ CallDestructBase(
     if (result != TCL_OK) {
 	return result;
     }
-    result = ItclDestructBase(interp, contextIoPtr, contextIoPtr->iclsPtr,
-	    flags);
+    result = ItclDestructBase(interp, contextIoPtr, flags);
     if (result != TCL_OK) {
 	return result;
     }
@@ -1341,38 +2211,30 @@ Itcl_DestructObject(
     ItclObject *contextIoPtr,  /* object to be destructed */
     int flags)	       /* flags: ITCL_IGNORE_ERRS */
 {
-    int result;
-
-    if ((contextIoPtr->flags & (ITCL_OBJECT_IS_DESTRUCTED))) {
-	    return TCL_OK;
-    }
-    contextIoPtr->flags |= ITCL_OBJECT_IS_DESTRUCTED;
-    /*
-     *  If there is a "destructed" table, then this object is already
-     *  being destructed.  Flag an error, unless errors are being
-     *  ignored.
-     */
-    if (contextIoPtr->destructed) {
-	if ((flags & ITCL_IGNORE_ERRS) == 0) {
-	    Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
-		"can't delete an object while it is being destructed",
-		(char *)NULL);
-	    return TCL_ERROR;
-	}
-	return TCL_OK;
+    int result;
+
+    if ((contextIoPtr->flags & (ITCL_OBJECT_IS_DESTRUCTED))) {
+	    return TCL_OK;
     }
+    contextIoPtr->flags |= ITCL_OBJECT_IS_DESTRUCTED;
 
     result = TCL_OK;
     if (contextIoPtr->oPtr != NULL) {
 	void *callbackPtr;
-	/*
-	 *  Create a "destructed" table to keep track of which destructors
-	 *  have been invoked.  This is used in ItclDestructBase to make
-	 *  sure that all base class destructors have been called,
-	 *  explicitly or implicitly.
-	 */
-	contextIoPtr->destructed = (Tcl_HashTable*)Tcl_Alloc(sizeof(Tcl_HashTable));
-	Tcl_InitHashTable(contextIoPtr->destructed, TCL_ONE_WORD_KEYS);
+	ItclClass *iclsPtr = contextIoPtr->iclsPtr;
+
+	if (!(iclsPtr->flags & ITCL_CLASS_LIFECYCLE_PLAN)) {
+	    ItclBuildLifecyclePlan(iclsPtr);
+	}
+	if ((iclsPtr->numDestructors == 0)
+		&& (contextIoPtr->hullWindowNamePtr == NULL)) {
+	    /*
+	     *  No destructors and no hull, so skip the callbacks.
+	     */
+	    ItclDeleteObjectVariablesNamespace(interp, contextIoPtr);
+	    Tcl_ResetResult(interp);
+	    return TCL_OK;
+	}
 
 	/*
 	 *  Destruct the object starting from the most-specific class.
@@ -1392,12 +2254,10 @@ Itcl_DestructObject(
  * ------------------------------------------------------------------------
  *  ItclDestructBase()
  *
- *  Invoked by Itcl_DestructObject() to recursively destruct an object
- *  from the specified class level.  Finds and invokes the destructor
- *  for the specified class, and then recursively destructs all base
- *  classes.  If the ITCL_IGNORE_ERRS flag is included, all destructors
- *  are invoked even if errors are encountered, and the result will
- *  always be TCL_OK.
+ *  Invoked by Itcl_DestructObject() to destruct an object.  Invokes the
+ *  destructors of the classes in the destructPlan of the object's class,
+ *  that is from most- to least-specific.  Classes without a destructor
+ *  are not visited at all.
  *
  *  Returns TCL_OK on success, or TCL_ERROR (along with an error message
  *  in interp->result) on error.
@@ -1407,44 +2267,26 @@ static int
 ItclDestructBase(
     Tcl_Interp *interp,	 /* interpreter */
     ItclObject *contextIoPtr,   /* object being destructed */
-    ItclClass *contextIclsPtr,  /* current class being destructed */
-    int flags)		  /* flags: ITCL_IGNORE_ERRS */
+    TCL_UNUSED(int))	  /* flags: ITCL_IGNORE_ERRS */
 {
-    int result;
-    Itcl_ListElem *elem;
-    ItclClass *iclsPtr;
+    ItclClass *iclsPtr = contextIoPtr->iclsPtr;
+    Tcl_Size i;
 
-    if (contextIoPtr->flags & ITCL_OBJECT_CLASS_DESTRUCTED) {
-	return TCL_OK;
-    }
-    /*
-     *  Ensure a destructor for this class is not already invoked yet.
-     */
-    if (Tcl_FindHashEntry(contextIoPtr->destructed,
-	    (char *)contextIclsPtr) == NULL) {
-	/*
-	 *  Look for a destructor in this class, and if found, invoke it.
-	 */
-	result = Itcl_InvokeMethodIfExists(interp, "destructor",
-	    contextIclsPtr, contextIoPtr, 0, NULL);
-	if (result != TCL_OK) {
-	    return TCL_ERROR;
+    for (i = 0; ; i++) {
+	if (!(iclsPtr->flags & ITCL_CLASS_LIFECYCLE_PLAN)) {
+	    /* a destructor changed the class, see ItclResetObjectPlans */
+	    ItclBuildLifecyclePlan(iclsPtr);
 	}
-    }
-
-    /*
-     *  Scan through the list of base classes recursively and destruct
-     *  them.  Traverse the list in normal order, so that we destruct
-     *  from most- to least-specific.
-     */
-    elem = Itcl_FirstListElem(&contextIclsPtr->bases);
-    while (elem) {
-	iclsPtr = (ItclClass*)Itcl_GetListValue(elem);
-
-	if (ItclDestructBase(interp, contextIoPtr, iclsPtr, flags) != TCL_OK) {
+	if (i >= iclsPtr->numDestructors) {
+	    break;
+	}
+	if (contextIoPtr->flags & ITCL_OBJECT_CLASS_DESTRUCTED) {
+	    return TCL_OK;
+	}
+	if (Itcl_InvokeMethodIfExists(interp, "destructor",
+		iclsPtr->destructPlan[i], contextIoPtr, 0, NULL) != TCL_OK) {
 	    return TCL_ERROR;
 	}
-	elem = Itcl_NextListElem(elem);
     }
 
     /*
@@ -1453,7 +2295,7 @@ ItclDestructBase(
     Tcl_ResetResult(interp);
     return TCL_OK;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_FindObject()
@@ -1566,15 +2408,70 @@ Itcl_ObjectIsa(
     ItclObject *contextIoPtr, /* object being tested */
     ItclClass *iclsPtr)       /* class to test for "is-a" relationship */
 {
-    Tcl_HashEntry *entry;
-
     if (contextIoPtr == NULL) {
 	return 0;
     }
-    entry = Tcl_FindHashEntry(&contextIoPtr->iclsPtr->heritage, (char*)iclsPtr);
-    return (entry != NULL);
+    return ItclClassIsa(contextIoPtr->iclsPtr, iclsPtr);
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclGetObjectVarSlot()
+ *
+ *  Returns the instance variable described by a lookup record for the
+ *  given object by indexing its varSlots array.  The slot kept in the
+ *  lookup record is valid for objects of every class that inherits the
+ *  variable through first base classes, which is checked by comparing
+ *  pointers only.  Classes that reach it through another base class
+ *  have a slot of their own, which the lookup record remembers for the
+ *  class it was last used with.  Returns NULL if the variable has no
+ *  slot; the caller then falls back to the objectVariables table.
+ * ------------------------------------------------------------------------
+ */
+Tcl_Var
+ItclGetObjectVarSlot(
+    ItclObject *ioPtr,         /* object context */
+    ItclVarLookup *vlookup)    /* lookup record of the variable */
+{
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
+    Tcl_HashEntry *hPtr;
+    Tcl_Size slotIndex;
+
+    if ((ioPtr->varSlots == NULL)
+	    || (ioPtr->varSlotsId != iclsPtr->varSlotsId)) {
+	return NULL;
+    }
+    slotIndex = vlookup->slotIndex;
+    if ((slotIndex >= 0) && (slotIndex < iclsPtr->numVarSlots)
+	    && (iclsPtr->slotVars[slotIndex] == vlookup->ivPtr)) {
+	return ioPtr->varSlots[slotIndex];
+    }
+
+    /*
+     *  The layout of the class of the variable may have been built
+     *  again since the lookup record was made.
+     */
+    slotIndex = ItclVarSlotIndex(vlookup->ivPtr);
+    if (slotIndex < 0) {
+	return NULL;
+    }
+    if ((slotIndex < iclsPtr->numVarSlots)
+	    && (iclsPtr->slotVars[slotIndex] == vlookup->ivPtr)) {
+	vlookup->slotIndex = slotIndex;
+	return ioPtr->varSlots[slotIndex];
+    }
+    if (vlookup->otherSlotsId != iclsPtr->varSlotsId) {
+	hPtr = Tcl_FindHashEntry(&iclsPtr->varSlotTable,
+		(char *)vlookup->ivPtr);
+	if (hPtr == NULL) {
+	    return NULL;
+	}
+	vlookup->otherSlotIndex = PTR2INT(Tcl_GetHashValue(hPtr));
+	vlookup->otherSlotsId = iclsPtr->varSlotsId;
+    }
+    return ioPtr->varSlots[vlookup->otherSlotIndex];
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclGetInstanceVar()
@@ -2057,17 +2954,175 @@ ItclReportObjectUsage(
 
 /*
  * ------------------------------------------------------------------------
- *  ItclTraceThisVar()
+ *  BuiltinVarValue()
  *
- *  Invoked to handle read/write traces on the "this" variable built
- *  into each object.
+ *  Returns a new object with the current value of the built-in
+ *  variable of kind "kind" (ITCL_THIS_VAR, ITCL_TYPE_VAR, ...) of an
+ *  object.  The variables are set to it when the object is created and
+ *  again when its access command is renamed or deleted, see
+ *  UpdateBuiltinVars(), so reading them involves no traces.
+ * ------------------------------------------------------------------------
+ */
+static Tcl_Obj *
+BuiltinVarValue(
+    ItclObject *ioPtr,
+    int kind)
+{
+    Tcl_Obj *objPtr;
+    Tcl_DString buffer;
+    const char *head;
+    const char *tail;
+    const char *objectName;
+
+    objPtr = Tcl_NewObj();
+    if ((kind == ITCL_SELF_VAR)
+	    && (ioPtr->iclsPtr->flags & (ITCL_WIDGET|ITCL_WIDGETADAPTOR))) {
+	objectName = ItclGetInstanceVar(ioPtr->interp, "itcl_hull", NULL,
+		ioPtr, ioPtr->iclsPtr);
+	if ((objectName == NULL) || (*objectName == '\0')) {
+	    Tcl_AppendObjToObj(objPtr, ioPtr->namePtr);
+	} else {
+	    Tcl_AppendToObj(objPtr, objectName, TCL_INDEX_NONE);
+	}
+	return objPtr;
+    }
+    switch (kind) {
+    case ITCL_THIS_VAR:
+    case ITCL_SELF_VAR:
+	if (ioPtr->accessCmd != NULL) {
+	    Tcl_GetCommandFullName(ioPtr->interp, ioPtr->accessCmd, objPtr);
+	}
+	break;
+    case ITCL_TYPE_VAR:
+	Tcl_AppendObjToObj(objPtr, ioPtr->iclsPtr->fullNamePtr);
+	break;
+    case ITCL_SELFNS_VAR:
+	Tcl_AppendObjToObj(objPtr, ioPtr->varNsNamePtr);
+	Tcl_AppendObjToObj(objPtr, ioPtr->iclsPtr->fullNamePtr);
+	break;
+    case ITCL_WIN_VAR:
+	/* a window path name must not contain namespace parts !! */
+	Itcl_ParseNamespPath(Tcl_GetString(ioPtr->origNamePtr), &buffer,
+		&head, &tail);
+	if (tail != NULL) {
+	    Tcl_AppendToObj(objPtr, tail, TCL_INDEX_NONE);
+	}
+	Tcl_DStringFree(&buffer);
+	break;
+    }
+    return objPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  BuiltinVarKind()
  *
- *  On read, this procedure updates the "this" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
+ *  Returns which of the built-in variables "ivPtr" is, as the
+ *  ITCL_*_VAR flag that BuiltinVarValue() expects, or 0.
+ * ------------------------------------------------------------------------
+ */
+static int
+BuiltinVarKind(
+    ItclVariable *ivPtr)
+{
+    if (ivPtr->flags & ITCL_THIS_VAR) {
+	return ITCL_THIS_VAR;
+    }
+    return ivPtr->flags & (ITCL_TYPE_VAR|ITCL_SELF_VAR|ITCL_SELFNS_VAR|
+	    ITCL_WIN_VAR);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  UpdateBuiltinVars()
  *
- *  On write, this procedure returns an error string, warning that
- *  the "this" variable cannot be set.
+ *  Sets the built-in variables of an object whose kind is in "mask"
+ *  to their current values.  Called when the access command of the
+ *  object is known, renamed or deleted, which is all that changes the
+ *  value of "this" and "self".  Variables that no longer exist, e.g.
+ *  because the object is being deleted, are left alone.
+ * ------------------------------------------------------------------------
+ */
+static void
+UpdateBuiltinVars(
+    ItclObject *ioPtr,
+    int mask)
+{
+    ItclClass *iclsPtr = ioPtr->iclsPtr;
+    ItclInitStep *stepPtr;
+    ItclInitStep *endPtr;
+    Tcl_Obj *namePtr;
+    Tcl_Obj *valuePtr;
+    int kind;
+
+    if (iclsPtr->initPlan == NULL) {
+	/*
+	 *  The class changed since its last object was created, see
+	 *  ItclResetObjectPlans().  The built-in variables are the same
+	 *  in the plan built now.
+	 */
+	Tcl_InterpState state = Tcl_SaveInterpState(ioPtr->interp, TCL_OK);
+
+	ItclInitVarSlots(iclsPtr);
+	if (ItclBuildInitPlan(ioPtr->interp, ioPtr, iclsPtr) != TCL_OK) {
+	    Tcl_RestoreInterpState(ioPtr->interp, state);
+	    return;
+	}
+	Tcl_RestoreInterpState(ioPtr->interp, state);
+    }
+    ioPtr->flags |= ITCL_OBJECT_UPDATING_BUILTINS;
+    endPtr = iclsPtr->initPlan + iclsPtr->numInitSteps;
+    for (stepPtr = iclsPtr->initPlan; stepPtr < endPtr; stepPtr++) {
+	if (stepPtr->op != ITCL_INIT_BUILTIN) {
+	    continue;
+	}
+	kind = BuiltinVarKind(stepPtr->ivPtr);
+	if (!(kind & mask)) {
+	    continue;
+	}
+	namePtr = ItclInstanceVarName(ioPtr, stepPtr->ivPtr);
+	Tcl_IncrRefCount(namePtr);
+	valuePtr = BuiltinVarValue(ioPtr, kind);
+	Tcl_IncrRefCount(valuePtr);
+	if (Tcl_ObjGetVar2(ioPtr->interp, namePtr, NULL, 0) != NULL) {
+	    Tcl_ObjSetVar2(ioPtr->interp, namePtr, NULL, valuePtr, 0);
+	}
+	Tcl_DecrRefCount(valuePtr);
+	Tcl_DecrRefCount(namePtr);
+    }
+    ioPtr->flags &= ~ITCL_OBJECT_UPDATING_BUILTINS;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  BuiltinVarWritten()
+ *
+ *  Common part of the write traces on the built-in variables: unless
+ *  UpdateBuiltinVars() is at work, puts the proper value back into the
+ *  variable.  Returns 1 if the write should be reported as an error.
+ * ------------------------------------------------------------------------
+ */
+static int
+BuiltinVarWritten(
+    ItclObject *ioPtr,
+    Tcl_Interp *interp,
+    const char *name1,
+    int kind)
+{
+    if (ioPtr->flags & ITCL_OBJECT_UPDATING_BUILTINS) {
+	return 0;
+    }
+    Tcl_SetVar2Ex(interp, name1, NULL, BuiltinVarValue(ioPtr, kind), 0);
+    return 1;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclTraceThisVar()
+ *
+ *  Invoked to handle write traces on the "this" variable built into
+ *  each object.  Returns an error string, warning that the "this"
+ *  variable cannot be set.
  * ------------------------------------------------------------------------
  */
 
@@ -2077,36 +3132,13 @@ ItclTraceThisVar(
     Tcl_Interp *interp,	  /* interpreter managing this variable */
     const char *name1,    /* variable name */
     TCL_UNUSED(const char *),/* unused */
-    int flags)		      /* flags indicating read/write */
+    TCL_UNUSED(int))	  /* flags indicating read/write */
 {
-    ItclObject *contextIoPtr = (ItclObject*)cdata;
-    Tcl_Obj *objPtr;
-    const char *objName;
-
     /* because of SF bug #187 use a different trace handler for "this", "win", "type"
      * *self" and "selfns"
      */
-
-    /*
-     *  Handle read traces on "this"
-     */
-    if ((flags & TCL_TRACE_READS) != 0) {
-	objPtr = Tcl_NewStringObj("", TCL_INDEX_NONE);
-	if (contextIoPtr->accessCmd) {
-	    Tcl_GetCommandFullName(contextIoPtr->iclsPtr->interp,
-		contextIoPtr->accessCmd, objPtr);
-	}
-	objName = Tcl_GetString(objPtr);
-	Tcl_SetVar2(interp, name1, NULL, objName, 0);
-
-	Tcl_DecrRefCount(objPtr);
-	return NULL;
-    }
-
-    /*
-     *  Handle write traces on "this"
-     */
-    if ((flags & TCL_TRACE_WRITES) != 0) {
+    if (BuiltinVarWritten((ItclObject *)cdata, interp, name1,
+	    ITCL_THIS_VAR)) {
 	return (char *)"variable \"this\" cannot be modified";
     }
     return NULL;
@@ -2116,15 +3148,10 @@ ItclTraceThisVar(
  * ------------------------------------------------------------------------
  *  ItclTraceWinVar()
  *
- *  Invoked to handle read/write traces on the "win" variable built
- *  into each object.
- *
- *  On read, this procedure updates the "win" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
- *
- *  On write, this procedure returns an error string, warning that
- *  the "win" variable cannot be set.
+ *  Invoked to handle write traces on the "win" variable built into
+ *  each object.  Returns an error string, warning that the "win"
+ *  variable cannot be set, except for extendedclass objects, where
+ *  the write is silently undone.
  * ------------------------------------------------------------------------
  */
 
@@ -2134,40 +3161,13 @@ ItclTraceWinVar(
     Tcl_Interp *interp,	  /* interpreter managing this variable */
     const char *name1,    /* variable name */
     TCL_UNUSED(const char *),/* unused */
-    int flags)	    /* flags indicating read/write */
+    TCL_UNUSED(int))	  /* flags indicating read/write */
 {
     ItclObject *contextIoPtr = (ItclObject*)cdata;
-    Tcl_DString buffer;
-    Tcl_Obj *objPtr;
-    const char *objName;
-    const char *head;
-    const char *tail;
-
-    /*
-     *  Handle read traces on "win"
-     */
-    if ((flags & TCL_TRACE_READS) != 0) {
-	objPtr = Tcl_NewStringObj("", TCL_INDEX_NONE);
-	/* a window path name must not contain namespace parts !! */
-	Itcl_ParseNamespPath(Tcl_GetString(contextIoPtr->origNamePtr), &buffer, &head, &tail);
-	if (tail == NULL) {
-	    return (char *)" INTERNAL ERROR tail == NULL in ItclTraceThisVar for win";
-	}
-	Tcl_SetStringObj(objPtr, tail, TCL_INDEX_NONE);
-	objName = Tcl_GetString(objPtr);
-	Tcl_SetVar2(interp, name1, NULL, objName, 0);
-
-	Tcl_DecrRefCount(objPtr);
-	return NULL;
-    }
 
-    /*
-     *  Handle write traces on "win"
-     */
-    if ((flags & TCL_TRACE_WRITES) != 0) {
-	if (!(contextIoPtr->iclsPtr->flags & ITCL_ECLASS)) {
-	    return (char *)"variable \"win\" cannot be modified";
-	}
+    if (BuiltinVarWritten(contextIoPtr, interp, name1, ITCL_WIN_VAR)
+	    && !(contextIoPtr->iclsPtr->flags & ITCL_ECLASS)) {
+	return (char *)"variable \"win\" cannot be modified";
     }
     return NULL;
 }
@@ -2176,15 +3176,9 @@ ItclTraceWinVar(
  * ------------------------------------------------------------------------
  *  ItclTraceTypeVar()
  *
- *  Invoked to handle read/write traces on the "type" variable built
- *  into each object.
- *
- *  On read, this procedure updates the "type" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
- *
- *  On write, this procedure returns an error string, warning that
- *  the "type" variable cannot be set.
+ *  Invoked to handle write traces on the "type" variable built into
+ *  each object.  Returns an error string, warning that the "type"
+ *  variable cannot be set.
  * ------------------------------------------------------------------------
  */
 
@@ -2194,30 +3188,10 @@ ItclTraceTypeVar(
     Tcl_Interp *interp,	  /* interpreter managing this variable */
     const char *name1,    /* variable name */
     TCL_UNUSED(const char *),/* unused */
-    int flags)	    /* flags indicating read/write */
+    TCL_UNUSED(int))	  /* flags indicating read/write */
 {
-    ItclObject *contextIoPtr = (ItclObject*)cdata;
-    Tcl_Obj *objPtr;
-    const char *objName;
-
-    /*
-     *  Handle read traces on "type"
-     */
-    if ((flags & TCL_TRACE_READS) != 0) {
-	objPtr = Tcl_NewStringObj("", TCL_INDEX_NONE);
-	Tcl_SetStringObj(objPtr,
-	Tcl_GetCurrentNamespace(contextIoPtr->iclsPtr->interp)->fullName, TCL_INDEX_NONE);
-	objName = Tcl_GetString(objPtr);
-	Tcl_SetVar2(interp, name1, NULL, objName, 0);
-
-	Tcl_DecrRefCount(objPtr);
-	return NULL;
-    }
-
-    /*
-     *  Handle write traces on "type"
-     */
-    if ((flags & TCL_TRACE_WRITES) != 0) {
+    if (BuiltinVarWritten((ItclObject *)cdata, interp, name1,
+	    ITCL_TYPE_VAR)) {
 	return (char *)"variable \"type\" cannot be modified";
     }
     return NULL;
@@ -2230,9 +3204,9 @@ ItclTraceTypeVar(
  *  Invoked to handle read/write traces on the "self" variable built
  *  into each object.
  *
- *  On read, this procedure updates the "self" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
+ *  On read, which is only traced for widgets, this procedure updates
+ *  the "self" variable to the current hull, which can change when the
+ *  hull is installed.
  *
  *  On write, this procedure returns an error string, warning that
  *  the "self" variable cannot be set.
@@ -2248,43 +3222,20 @@ ItclTraceSelfVar(
     int flags)	    /* flags indicating read/write */
 {
     ItclObject *contextIoPtr = (ItclObject*)cdata;
-    Tcl_Obj *objPtr;
-    const char *objName;
 
     /*
      *  Handle read traces on "self"
      */
     if ((flags & TCL_TRACE_READS) != 0) {
-	objPtr = Tcl_NewStringObj("", TCL_INDEX_NONE);
-	if (contextIoPtr->iclsPtr->flags &
-		(ITCL_WIDGET|ITCL_WIDGETADAPTOR)) {
-	    const char *objectName;
-
-	    objectName = ItclGetInstanceVar(
-		    contextIoPtr->iclsPtr->interp,
-		    "itcl_hull", NULL, contextIoPtr,
-		    contextIoPtr->iclsPtr);
-	    if (strlen(objectName) == 0) {
-		objPtr = contextIoPtr->namePtr;
-		Tcl_IncrRefCount(objPtr);
-	    } else {
-		Tcl_SetStringObj(objPtr, objectName, TCL_INDEX_NONE);
-	    }
-	} else {
-	    Tcl_GetCommandFullName(contextIoPtr->iclsPtr->interp,
-		    contextIoPtr->accessCmd, objPtr);
-	}
-	objName = Tcl_GetString(objPtr);
-	Tcl_SetVar2(interp, name1, NULL, objName, 0);
-
-	Tcl_DecrRefCount(objPtr);
+	Tcl_SetVar2Ex(interp, name1, NULL,
+		BuiltinVarValue(contextIoPtr, ITCL_SELF_VAR), 0);
 	return NULL;
     }
 
     /*
      *  Handle write traces on "self"
      */
-    if ((flags & TCL_TRACE_WRITES) != 0) {
+    if (BuiltinVarWritten(contextIoPtr, interp, name1, ITCL_SELF_VAR)) {
 	return (char *)"variable \"self\" cannot be modified";
     }
     return NULL;
@@ -2294,15 +3245,9 @@ ItclTraceSelfVar(
  * ------------------------------------------------------------------------
  *  ItclTraceSelfnsVar()
  *
- *  Invoked to handle read/write traces on the "selfns" variable built
- *  into each object.
- *
- *  On read, this procedure updates the "selfns" variable to contain the
- *  current object name.  This is done dynamically, since an object's
- *  identity can change if its access command is renamed.
- *
- *  On write, this procedure returns an error string, warning that
- *  the "selfns" variable cannot be set.
+ *  Invoked to handle write traces on the "selfns" variable built into
+ *  each object.  Returns an error string, warning that the "selfns"
+ *  variable cannot be set.
  * ------------------------------------------------------------------------
  */
 
@@ -2312,87 +3257,15 @@ ItclTraceSelfnsVar(
     Tcl_Interp *interp,	  /* interpreter managing this variable */
     const char *name1,    /* variable name */
     TCL_UNUSED(const char *),/* unused */
-    int flags)		  /* flags indicating read/write */
+    TCL_UNUSED(int))	  /* flags indicating read/write */
 {
-    ItclObject *contextIoPtr = (ItclObject*)cdata;
-    Tcl_Obj *objPtr;
-    const char *objName;
-
-    /*
-     *  Handle read traces on "selfns"
-     */
-    if ((flags & TCL_TRACE_READS) != 0) {
-	objPtr = Tcl_NewStringObj("", TCL_INDEX_NONE);
-	Tcl_SetStringObj(objPtr, Tcl_GetString(contextIoPtr->varNsNamePtr), TCL_INDEX_NONE);
-	Tcl_AppendToObj(objPtr,
-		Tcl_GetString(contextIoPtr->iclsPtr->fullNamePtr), TCL_INDEX_NONE);
-	objName = Tcl_GetString(objPtr);
-	Tcl_SetVar2(interp, name1, NULL, objName, 0);
-
-	Tcl_DecrRefCount(objPtr);
-	return NULL;
-    }
-
-    /*
-     *  Handle write traces on "selfns"
-     */
-    if ((flags & TCL_TRACE_WRITES) != 0) {
+    if (BuiltinVarWritten((ItclObject *)cdata, interp, name1,
+	    ITCL_SELFNS_VAR)) {
 	return (char *)"variable \"selfns\" cannot be modified";
     }
     return NULL;
 }
-
-/*
- * ------------------------------------------------------------------------
- *  ItclTraceOptionVar()
- *
- *  Invoked to handle read/write traces on "option" variables
- *
- *  On read, this procedure checks if there is a cgetMethodPtr and calls it
- *  On write, this procedure checks if there is a configureMethodPtr
- *  or validateMethodPtr and calls it
- * ------------------------------------------------------------------------
- */
 
-static char*
-ItclTraceOptionVar(
-    void *cdata,	    /* object instance data */
-    TCL_UNUSED(Tcl_Interp *),/* interpreter managing this variable */
-    TCL_UNUSED(const char *),/* variable name */
-    TCL_UNUSED(const char *),/* unused */
-    int flags)	      /* flags indicating read/write */
-{
-    ItclObject *ioPtr;
-    ItclOption *ioptPtr;
-
-/* FIXME !!! */
-/* don't know yet if ItclTraceOptionVar is really needed !! */
-/* FIXME should free memory on unset or rename!! */
-    if (cdata != NULL) {
-	ioPtr = (ItclObject*)cdata;
-	if (ioPtr == NULL) {
-	}
-    } else {
-	ioptPtr = (ItclOption*)cdata;
-	if (ioptPtr == NULL) {
-	}
-	/*
-	 *  Handle read traces "itcl_options"
-	 */
-	if ((flags & TCL_TRACE_READS) != 0) {
-	    return NULL;
-	}
-
-	/*
-	 *  Handle write traces "itcl_options"
-	 */
-	if ((flags & TCL_TRACE_WRITES) != 0) {
-	    return NULL;
-	}
-    }
-    return NULL;
-}
-
 /*
  * ------------------------------------------------------------------------
  *  ItclTraceComponentVar()
@@ -2410,63 +3283,74 @@ ItclTraceComponentVar(
     TCL_UNUSED(const char *),/* unused */
     int flags)	      /* flags indicating read/write */
 {
-    FOREACH_HASH_DECLS;
-    Tcl_HashEntry *hPtr2;
+    Tcl_HashEntry *hPtr;
     Tcl_Obj *objPtr;
-    Tcl_Obj *namePtr;
-    Tcl_Obj *componentValuePtr;
     ItclObjectInfo *infoPtr;
     ItclObject *ioPtr;
     ItclComponent *icPtr;
-    ItclDelegatedFunction *idmPtr;
-    const char *val;
+    Tcl_Obj *valuePtr;
+    Tcl_Obj *oldValuePtr;
+    const char *varName;
+    const char *tail;
+    int isNew;
 
 /* FIXME should free memory on unset or rename!! */
     if (cdata != NULL) {
 	ioPtr = (ItclObject*)cdata;
-	infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
-		ITCL_INTERP_DATA, NULL);
+	infoPtr = ioPtr->infoPtr;
 	hPtr = Tcl_FindHashEntry(&infoPtr->objects, (char *)ioPtr);
 	if (hPtr == NULL) {
 	    /* object does no longer exist or is being destructed */
 	    return NULL;
 	}
+	/* the variable may have been accessed by its qualified name */
+	varName = name1;
+	tail = strrchr(name1, ':');
+	if (tail != NULL) {
+	    name1 = tail + 1;
+	}
 	objPtr = Tcl_NewStringObj(name1, TCL_INDEX_NONE);
-	hPtr = Tcl_FindHashEntry(&ioPtr->objectComponents, (char *)objPtr);
+	hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(ioPtr)->objectComponents, (char *)objPtr);
 	Tcl_DecrRefCount(objPtr);
 
 	/*
 	 *  Handle write traces
 	 */
 	if ((flags & TCL_TRACE_WRITES) != 0) {
-	    if (ioPtr->noComponentTrace) {
-		return NULL;
-	    }
 	    /* need to redo the delegation for this component !! */
 	    if (hPtr == NULL) {
+		if (ioPtr->noComponentTrace) {
+		    return NULL;
+		}
 		return (char *)" INTERNAL ERROR cannot get component to write to";
 	    }
 	    icPtr = (ItclComponent *)Tcl_GetHashValue(hPtr);
-	    val = ItclGetInstanceVar(interp, name1, NULL, ioPtr,
-		    ioPtr->iclsPtr);
-	    if ((val == NULL) || (strlen(val) == 0)) {
-		return (char *)" INTERNAL ERROR cannot get value for component";
+	    hPtr = Tcl_CreateHashEntry(&ioPtr->extPtr->componentValues,
+		    (char *)icPtr, &isNew);
+	    valuePtr = NULL;
+	    if (!ioPtr->noComponentTrace) {
+		valuePtr = Tcl_GetVar2Ex(interp, varName, NULL, 0);
 	    }
-	    componentValuePtr = Tcl_NewStringObj(val, TCL_INDEX_NONE);
-	    Tcl_IncrRefCount(componentValuePtr);
-	    namePtr = Tcl_NewStringObj(name1, TCL_INDEX_NONE);
-	    FOREACH_HASH_VALUE(idmPtr, &ioPtr->iclsPtr->delegatedFunctions) {
-		if (idmPtr->icPtr == icPtr) {
-		    hPtr2 = Tcl_FindHashEntry(&idmPtr->exceptions,
-			    (char *)namePtr);
-		    if (hPtr2 == NULL) {
-			DelegateFunction(interp, ioPtr, ioPtr->iclsPtr,
-				  componentValuePtr, idmPtr);
-		     }
+	    if (!isNew) {
+		oldValuePtr = (Tcl_Obj *)Tcl_GetHashValue(hPtr);
+		if ((valuePtr != NULL) && ((valuePtr == oldValuePtr)
+			|| (strcmp(Tcl_GetString(valuePtr),
+			Tcl_GetString(oldValuePtr)) == 0))) {
+		    /* rebound to the same component, nothing to do */
+		    return NULL;
 		}
+		Tcl_DecrRefCount(oldValuePtr);
 	    }
-	    Tcl_DecrRefCount(componentValuePtr);
-	    Tcl_DecrRefCount(namePtr);
+	    if (valuePtr == NULL) {
+		Tcl_DeleteHashEntry(hPtr);
+	    } else {
+		Tcl_IncrRefCount(valuePtr);
+		Tcl_SetHashValue(hPtr, valuePtr);
+	    }
+	    if (ioPtr->noComponentTrace) {
+		return NULL;
+	    }
+	    ForgetComponentDelegations(ioPtr, icPtr);
 	    return NULL;
 	}
 	/*
@@ -2618,7 +3502,11 @@ ItclDestroyObject(
 	if (hPtr) {
 	    Tcl_DeleteHashEntry(hPtr);
 	}
+	RemoveObjectInstance(contextIoPtr);
 	contextIoPtr->accessCmd = NULL;
+	if (contextIoPtr->flags & ITCL_OBJECT_SHOULD_VARNS_DELETE) {
+	    UpdateBuiltinVars(contextIoPtr, ITCL_THIS_VAR|ITCL_SELF_VAR);
+	}
     }
     Itcl_ReleaseData(contextIoPtr);
 }
@@ -2636,12 +3524,12 @@ FreeObject(
     char * cdata)  /* object instance data */
 {
     FOREACH_HASH_DECLS;
-    Tcl_HashSearch place;
-    ItclCallContext *callContextPtr;
     ItclObject *ioPtr;
     Tcl_Var var;
+    int i;
 
     ioPtr = (ItclObject*)cdata;
+    RemoveObjectInstance(ioPtr);
 
     /*
      *  Install the class namespace and object context so that
@@ -2660,34 +3548,34 @@ FreeObject(
 	Tcl_DeleteHashTable(ioPtr->constructed);
 	Tcl_Free(ioPtr->constructed);
     }
-    if (ioPtr->destructed) {
-	Tcl_DeleteHashTable(ioPtr->destructed);
-	Tcl_Free(ioPtr->destructed);
-    }
-    ItclDeleteObjectsDictInfo(ioPtr->interp, ioPtr);
     /*
      *  Delete all context definitions.
      */
-    while (1) {
-	hPtr = Tcl_FirstHashEntry(&ioPtr->contextCache, &place);
-	if (hPtr == NULL) {
-	    break;
+    for (i = 0; i < ITCL_CONTEXT_SLOTS; i++) {
+	if (ioPtr->contextSlots[i] != NULL) {
+	    Tcl_Free(ioPtr->contextSlots[i]);
 	}
-	callContextPtr = (ItclCallContext *)Tcl_GetHashValue(hPtr);
-	Tcl_DeleteHashEntry(hPtr);
-	Tcl_Free(callContextPtr);
     }
     FOREACH_HASH_VALUE(var, &ioPtr->objectVariables) {
 	Itcl_ReleaseVar(var);
     }
+    if (ioPtr->optionsVarPtr != NULL) {
+	Itcl_ReleaseVar(ioPtr->optionsVarPtr);
+    }
+    if (ioPtr->optionComponentsVarPtr != NULL) {
+	Itcl_ReleaseVar(ioPtr->optionComponentsVarPtr);
+    }
+    if (ioPtr->varSlots != NULL) {
+	Tcl_Free(ioPtr->varSlots);
+    }
+    if (ioPtr->configReportPtr != NULL) {
+	Tcl_DecrRefCount(ioPtr->configReportPtr);
+    }
 
-    Tcl_DeleteHashTable(&ioPtr->contextCache);
     Tcl_DeleteHashTable(&ioPtr->objectVariables);
-    Tcl_DeleteHashTable(&ioPtr->objectOptions);
-    Tcl_DeleteHashTable(&ioPtr->objectComponents);
-    Tcl_DeleteHashTable(&ioPtr->objectMethodVariables);
-    Tcl_DeleteHashTable(&ioPtr->objectDelegatedOptions);
-    Tcl_DeleteHashTable(&ioPtr->objectDelegatedFunctions);
+    if (ioPtr->extPtr != NULL) {
+	ItclFreeObjectExt(ioPtr->extPtr);
+    }
     Tcl_DecrRefCount(ioPtr->namePtr);
     Tcl_DecrRefCount(ioPtr->origNamePtr);
     if (ioPtr->createNamePtr != NULL) {
@@ -2784,8 +3672,14 @@ ItclObjectCmd(
     }
     methodNamePtr = NULL;
     if (objv[0] != NULL) {
-	Itcl_ParseNamespPath(Tcl_GetString(objv[0]), &buffer,
-		&className, &tail);
+	/* most calls are unqualified, don't bother to parse those */
+	if (strstr(Tcl_GetString(objv[0]), "::") == NULL) {
+	    className = NULL;
+	    Tcl_DStringInit(&buffer);
+	} else {
+	    Itcl_ParseNamespPath(Tcl_GetString(objv[0]), &buffer,
+		    &className, &tail);
+	}
 	if (className != NULL) {
 	    methodNamePtr = Tcl_NewStringObj(tail, TCL_INDEX_NONE);
 	    /* look for the class in the hierarchy */
@@ -2979,9 +3873,101 @@ GetClassFromClassName(
     return iclsPtr;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  FindMethodCacheEntry()
+ *
+ *  Looks up an unqualified method name called from nsPtr in the method
+ *  cache of a class.  Entries are valid until the next
+ *  Itcl_BuildVirtualTables() of any class.  Returns NULL on a miss.
+ * ------------------------------------------------------------------------
+ */
+static ItclMethodCacheEntry *
+FindMethodCacheEntry(
+    ItclClass *iclsPtr,
+    Tcl_Namespace *nsPtr,
+    const char *name,
+    Tcl_Size length)
+{
+    ItclMethodCacheEntry *entryPtr;
+    const char *cachedName;
+    Tcl_Size cachedLength;
+    int i;
+
+    for (i = 0; i < ITCL_METHOD_CACHE_SLOTS; i++) {
+	entryPtr = &iclsPtr->methodCache[i];
+	if ((entryPtr->namePtr == NULL) || (entryPtr->nsPtr != nsPtr)
+		|| (entryPtr->epoch != iclsPtr->infoPtr->methodCacheEpoch)) {
+	    continue;
+	}
+	cachedName = Tcl_GetStringFromObj(entryPtr->namePtr, &cachedLength);
+	if ((cachedLength == length)
+		&& (memcmp(cachedName, name, length) == 0)) {
+	    return entryPtr;
+	}
+    }
+    return NULL;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  AddMethodCacheEntry()
+ *
+ *  Remembers how an unqualified method name called from nsPtr was
+ *  mapped, replacing the entries of a class round robin.
+ * ------------------------------------------------------------------------
+ */
+static void
+AddMethodCacheEntry(
+    ItclClass *iclsPtr,
+    Tcl_Namespace *nsPtr,
+    const char *name,
+    Tcl_Size length,
+    ItclCmdLookup *clookupPtr)
+{
+    ItclMethodCacheEntry *entryPtr;
+
+    entryPtr = &iclsPtr->methodCache[iclsPtr->nextMethodCacheSlot];
+    iclsPtr->nextMethodCacheSlot =
+	    (iclsPtr->nextMethodCacheSlot + 1) % ITCL_METHOD_CACHE_SLOTS;
+    if (entryPtr->namePtr != NULL) {
+	Tcl_DecrRefCount(entryPtr->namePtr);
+    }
+    entryPtr->namePtr = Tcl_NewStringObj(name, length);
+    Tcl_IncrRefCount(entryPtr->namePtr);
+    entryPtr->nsPtr = nsPtr;
+    entryPtr->epoch = iclsPtr->infoPtr->methodCacheEpoch;
+    entryPtr->clookupPtr = clookupPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclFreeMethodCache()
+ *
+ *  Releases the method cache of a class that is going away.
+ * ------------------------------------------------------------------------
+ */
+void
+ItclFreeMethodCache(
+    ItclClass *iclsPtr)
+{
+    int i;
+
+    for (i = 0; i < ITCL_METHOD_CACHE_SLOTS; i++) {
+	if (iclsPtr->methodCache[i].namePtr != NULL) {
+	    Tcl_DecrRefCount(iclsPtr->methodCache[i].namePtr);
+	    iclsPtr->methodCache[i].namePtr = NULL;
+	}
+    }
+}
+
 /*
  * ------------------------------------------------------------------------
  *  ItclMapMethodNameProc()
+ *
+ *  Unqualified names of public methods called from outside of any
+ *  class namespace are cached per class, so that repeated calls skip
+ *  the name parsing and the method table lookups.
  * ------------------------------------------------------------------------
  */
 
@@ -3001,9 +3987,12 @@ ItclMapMethodNameProc(
     ItclClass *iclsPtr;
     ItclClass *iclsPtr2;
     ItclObjectInfo *infoPtr;
+    ItclMethodCacheEntry *entryPtr;
     const char *head;
     const char *tail;
     const char *sp;
+    Tcl_Size length;
+    int cacheable;
 
     iclsPtr = NULL;
     iclsPtr2 = NULL;
@@ -3034,14 +4023,23 @@ ItclMapMethodNameProc(
 	}
 	iclsPtr = ioPtr->iclsPtr;
     }
-    sp = Tcl_GetString(methodObj);
+    sp = Tcl_GetStringFromObj(methodObj, &length);
+    myNsPtr = Tcl_GetCurrentNamespace(iclsPtr->interp);
+    entryPtr = FindMethodCacheEntry(iclsPtr, myNsPtr, sp, length);
+    if (entryPtr != NULL) {
+	if (entryPtr->clookupPtr == NULL) {
+	    *startClsPtr = NULL;
+	}
+	return TCL_OK;
+    }
+    cacheable = 0;
     Itcl_ParseNamespPath(sp, &buffer, &head, &tail);
     if (head == NULL) {
 	/* itcl bug #3600923 call private method in class
 	 * without namespace
 	 */
-	myNsPtr = Tcl_GetCurrentNamespace(iclsPtr->interp);
 	hPtr = Tcl_FindHashEntry(&infoPtr->namespaceClasses, (char *) myNsPtr);
+	cacheable = (hPtr == NULL);
 	if (hPtr) {
 	    iclsPtr2 = (ItclClass *) Tcl_GetHashValue(hPtr);
 	    if (Itcl_IsMethodCallFrame(iclsPtr->interp) > 0) {
@@ -3077,6 +4075,9 @@ ItclMapMethodNameProc(
 	 * fossil ticket id: 36577626c340ad59615f0a0238d67872c009a8c9
 	 */
 	*startClsPtr = NULL;
+	if (cacheable) {
+	    AddMethodCacheEntry(iclsPtr, myNsPtr, sp, length, NULL);
+	}
     } else {
 	ItclMemberFunc *imPtr;
 	Tcl_Namespace *nsPtr;
@@ -3085,6 +4086,9 @@ ItclMapMethodNameProc(
 	nsPtr = Tcl_GetCurrentNamespace(interp);
 	clookup = (ItclCmdLookup *)Tcl_GetHashValue(hPtr);
 	imPtr = clookup->imPtr;
+	if (cacheable && (imPtr->protection == ITCL_PUBLIC)) {
+	    AddMethodCacheEntry(iclsPtr, myNsPtr, sp, length, clookup);
+	}
 	if (!Itcl_CanAccessFunc(imPtr, nsPtr)) {
 	    char *token = Tcl_GetString(imPtr->namePtr);
 	    if ((*token != 'i') || (strcmp(token, "info") != 0)) {
@@ -3380,12 +4384,61 @@ ExpandDelegateAs(
 
 /*
  * ------------------------------------------------------------------------
- *  DelegationFunction()
+ *  DelegationComponentValue()
+ *
+ *  Returns the current value of the component a delegated method is
+ *  forwarded to, or NULL if it has no component.
  * ------------------------------------------------------------------------
  */
 
-int
-DelegateFunction(
+static Tcl_Obj *
+DelegationComponentValue(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclDelegatedFunction *idmPtr)
+{
+    Tcl_Obj *objPtr;
+    Tcl_Obj *valuePtr;
+    ItclVariable *ivPtr;
+
+    if (idmPtr->icPtr == NULL) {
+	return NULL;
+    }
+    /* we cannot use Itcl_GetInstanceVar here as the object may not
+     * yet be completely built. So use the varNsNamePtr
+     */
+    ivPtr = idmPtr->icPtr->ivPtr;
+    if (ivPtr->flags & ITCL_COMMON) {
+	objPtr = Tcl_NewStringObj(ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
+	Tcl_AppendToObj(objPtr, (Tcl_GetObjectNamespace(
+		ivPtr->iclsPtr->oPtr))->fullName, TCL_INDEX_NONE);
+	Tcl_AppendToObj(objPtr, "::", TCL_INDEX_NONE);
+	Tcl_AppendToObj(objPtr,
+		Tcl_GetString(idmPtr->icPtr->namePtr), TCL_INDEX_NONE);
+    } else {
+	objPtr = ItclInstanceVarName(ioPtr, ivPtr);
+    }
+    Tcl_IncrRefCount(objPtr);
+    valuePtr = Tcl_ObjGetVar2(interp, objPtr, NULL, 0);
+    Tcl_DecrRefCount(objPtr);
+    if (valuePtr == NULL) {
+	valuePtr = Tcl_NewObj();
+    }
+    return valuePtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  DelegationPrefix()
+ *
+ *  Builds the command prefix calls of a delegated method are forwarded
+ *  to for an object: the component followed by the expansion of the
+ *  "as" or "using" part of the delegation.  Returns NULL on error.
+ * ------------------------------------------------------------------------
+ */
+
+static Tcl_Obj *
+DelegationPrefix(
     Tcl_Interp *interp,
     ItclObject *ioPtr,
     ItclClass *iclsPtr,
@@ -3393,9 +4446,6 @@ DelegateFunction(
     ItclDelegatedFunction *idmPtr)
 {
     Tcl_Obj *listPtr;
-    const char *val;
-    int result;
-    Tcl_Method mPtr;
 
     listPtr = Tcl_NewListObj(0, NULL);
     if (componentValuePtr != NULL) {
@@ -3403,33 +4453,228 @@ DelegateFunction(
 	    Tcl_ListObjAppendElement(interp, listPtr, componentValuePtr);
 	}
     }
-    result = ExpandDelegateAs(interp, ioPtr, iclsPtr, idmPtr,
-	    Tcl_GetString(idmPtr->namePtr), listPtr);
-    if (result != TCL_OK) {
+    if (ExpandDelegateAs(interp, ioPtr, iclsPtr, idmPtr,
+	    Tcl_GetString(idmPtr->namePtr), listPtr) != TCL_OK) {
 	Tcl_DecrRefCount(listPtr);
-	return result;
+	return NULL;
     }
-    val = Tcl_GetString(listPtr);
-    if (val == NULL) {
-	/* FIXME need code here */
+    return listPtr;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  SetDelegationPrefix()
+ *
+ *  Stores the prefix of a delegated method in the delegation plan of
+ *  an object, replacing the previous one.
+ * ------------------------------------------------------------------------
+ */
+
+static void
+SetDelegationPrefix(
+    ItclObject *ioPtr,
+    ItclDelegatedFunction *idmPtr,
+    Tcl_Obj *prefixPtr)
+{
+    Tcl_HashEntry *hPtr;
+    int isNew;
+
+    hPtr = Tcl_CreateHashEntry(&ItclGetObjectExt(ioPtr)->delegationPlans,
+	    (char *)idmPtr, &isNew);
+    Tcl_IncrRefCount(prefixPtr);
+    if (!isNew) {
+	Tcl_DecrRefCount((Tcl_Obj *)Tcl_GetHashValue(hPtr));
     }
-    if (componentValuePtr != NULL) {
-	mPtr = Itcl_NewForwardClassMethod(interp, iclsPtr->clsPtr, 1,
-		idmPtr->namePtr, listPtr);
-	if (mPtr != NULL) {
-	    return TCL_OK;
+    Tcl_SetHashValue(hPtr, prefixPtr);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ForgetDelegationPrefix()
+ *
+ *  Removes the prefix of a delegated method from the delegation plan
+ *  of an object.
+ * ------------------------------------------------------------------------
+ */
+
+static void
+ForgetDelegationPrefix(
+    ItclObject *ioPtr,
+    ItclDelegatedFunction *idmPtr)
+{
+    Tcl_HashEntry *hPtr;
+
+    hPtr = Tcl_FindHashEntry(&ioPtr->extPtr->delegationPlans,
+	    (char *)idmPtr);
+    if (hPtr != NULL) {
+	Tcl_DecrRefCount((Tcl_Obj *)Tcl_GetHashValue(hPtr));
+	Tcl_DeleteHashEntry(hPtr);
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ForgetComponentDelegations()
+ *
+ *  Removes the prefixes of all delegated methods going to a component
+ *  from the delegation plan of an object, so that the next call of
+ *  each looks the component up again, see ItclDelegationPrefix().
+ *  Walks whichever is shorter, the plan or the delegated methods of
+ *  the component.
+ * ------------------------------------------------------------------------
+ */
+
+static void
+ForgetComponentDelegations(
+    ItclObject *ioPtr,
+    ItclComponent *icPtr)
+{
+    FOREACH_HASH_DECLS;
+    ItclDelegatedFunction *idmPtr;
+    Tcl_Obj *prefixPtr;
+    Itcl_List *listPtr;
+    Itcl_ListElem *elem;
+
+    if (ioPtr->extPtr->delegationPlans.numEntries == 0) {
+	return;
+    }
+    listPtr = ItclComponentDelegations(ioPtr->iclsPtr, icPtr);
+    if (listPtr == NULL) {
+	return;
+    }
+    if (ioPtr->extPtr->delegationPlans.numEntries
+	    < Itcl_GetListLength(listPtr)) {
+	FOREACH_HASH(idmPtr, prefixPtr, &ioPtr->extPtr->delegationPlans) {
+	    if ((idmPtr->icPtr == icPtr) && (Tcl_FindHashEntry(
+		    &idmPtr->exceptions, (char *)icPtr->namePtr) == NULL)) {
+		Tcl_DecrRefCount(prefixPtr);
+		Tcl_DeleteHashEntry(hPtr);
+	    }
 	}
+	return;
     }
-    if (idmPtr->usingPtr != NULL) {
-	mPtr = Itcl_NewForwardClassMethod(interp, iclsPtr->clsPtr, 1,
-		idmPtr->namePtr, listPtr);
-	if (mPtr != NULL) {
-	    return TCL_OK;
+    for (elem = Itcl_FirstListElem(listPtr); elem != NULL;
+	    elem = Itcl_NextListElem(elem)) {
+	ForgetDelegationPrefix(ioPtr,
+		(ItclDelegatedFunction *)Itcl_GetListValue(elem));
+    }
+}
+
+/*
+ * ------------------------------------------------------------------------
+ *  ItclDelegationPrefix()
+ *
+ *  Called for each call of a delegated method installed by
+ *  DelegateFunction() to get the prefix to forward to for the object.
+ *  The prefix is taken from the delegation plan of the object.  Writes
+ *  to the component drop it from the plan, see ItclTraceComponentVar(),
+ *  and it is built again here on the next call.
+ * ------------------------------------------------------------------------
+ */
+
+static Tcl_Obj *
+ItclDelegationPrefix(
+    void *clientData,
+    Tcl_Interp *interp,
+    Tcl_Object oPtr)
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_Obj *componentValuePtr;
+    Tcl_Obj *prefixPtr;
+    ItclDelegatedFunction *idmPtr;
+    ItclObjectInfo *infoPtr;
+    ItclObject *ioPtr;
+
+    idmPtr = (ItclDelegatedFunction *)clientData;
+    infoPtr = (ItclObjectInfo *)Tcl_GetAssocData(interp,
+	    ITCL_INTERP_DATA, NULL);
+    ioPtr = (ItclObject *)Tcl_ObjectGetMetadata(oPtr,
+	    infoPtr->object_meta_type);
+    if (ioPtr == NULL) {
+	Tcl_AppendResult(interp, "cannot call delegated method \"",
+		Tcl_GetString(idmPtr->namePtr), "\" of a deleted object",
+		(char *)NULL);
+	return NULL;
+    }
+    if (ioPtr->extPtr != NULL) {
+	hPtr = Tcl_FindHashEntry(&ioPtr->extPtr->delegationPlans,
+		(char *)idmPtr);
+	if (hPtr != NULL) {
+	    return (Tcl_Obj *)Tcl_GetHashValue(hPtr);
 	}
     }
-    return TCL_ERROR;
+    /* the value seen by the last write of the component is current */
+    componentValuePtr = NULL;
+    if ((ioPtr->extPtr != NULL) && (idmPtr->icPtr != NULL)) {
+	hPtr = Tcl_FindHashEntry(&ioPtr->extPtr->componentValues,
+		(char *)idmPtr->icPtr);
+	if (hPtr != NULL) {
+	    componentValuePtr = (Tcl_Obj *)Tcl_GetHashValue(hPtr);
+	}
+    }
+    if (componentValuePtr == NULL) {
+	componentValuePtr = DelegationComponentValue(interp, ioPtr, idmPtr);
+    }
+    if (componentValuePtr != NULL) {
+	Tcl_IncrRefCount(componentValuePtr);
+    }
+    prefixPtr = DelegationPrefix(interp, ioPtr, ioPtr->iclsPtr,
+	    componentValuePtr, idmPtr);
+    if (componentValuePtr != NULL) {
+	Tcl_DecrRefCount(componentValuePtr);
+    }
+    if (prefixPtr != NULL) {
+	SetDelegationPrefix(ioPtr, idmPtr, prefixPtr);
+    }
+    return prefixPtr;
 }
-
+
+/*
+ * ------------------------------------------------------------------------
+ *  DelegationFunction()
+ *
+ *  Records the prefix a delegated method forwards to in the delegation
+ *  plan of an object and installs the method in the class on first use.
+ *  The method looks the prefix up for each call, so objects of the
+ *  class with different components don't share their targets.
+ * ------------------------------------------------------------------------
+ */
+
+int
+DelegateFunction(
+    Tcl_Interp *interp,
+    ItclObject *ioPtr,
+    ItclClass *iclsPtr,
+    Tcl_Obj *componentValuePtr,
+    ItclDelegatedFunction *idmPtr)
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_Obj *listPtr;
+    Tcl_Method mPtr;
+    int isNew;
+
+    if ((componentValuePtr == NULL) && (idmPtr->usingPtr == NULL)) {
+	return TCL_ERROR;
+    }
+    listPtr = DelegationPrefix(interp, ioPtr, iclsPtr, componentValuePtr,
+	    idmPtr);
+    if (listPtr == NULL) {
+	return TCL_ERROR;
+    }
+    SetDelegationPrefix(ioPtr, idmPtr, listPtr);
+    hPtr = Tcl_CreateHashEntry(&iclsPtr->delegateMethods, (char *)idmPtr,
+	    &isNew);
+    if (isNew) {
+	mPtr = Itcl_NewDelegateClassMethod(interp, iclsPtr->clsPtr, 1,
+		idmPtr->namePtr, ItclDelegationPrefix, idmPtr);
+	if (mPtr == NULL) {
+	    Tcl_DeleteHashEntry(hPtr);
+	    return TCL_ERROR;
+	}
+    }
+    return TCL_OK;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  DelegatedOptionsInstall()
@@ -3492,7 +4737,6 @@ GetConstructorVar(
 {
     Tcl_HashEntry *hPtr;
     Tcl_Obj *objPtr;
-    Tcl_DString buffer;
     ItclVarLookup *vlookup;
     ItclVariable *ivPtr;
     const char *val;
@@ -3521,14 +4765,9 @@ GetConstructorVar(
 	Tcl_DecrRefCount(objPtr);
     } else {
 	/* look for a normal variable */
-	Tcl_DStringInit(&buffer);
-	Tcl_DStringAppend(&buffer,
-		Tcl_GetString(iclsPtr->infoPtr->currIoPtr->varNsNamePtr), TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer, ivPtr->iclsPtr->nsPtr->fullName, TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer, "::", TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer, varName, TCL_INDEX_NONE);
-	val = Tcl_GetVar2(interp, Tcl_DStringValue(&buffer), NULL, 0);
-	Tcl_DStringFree(&buffer);
+	objPtr = ItclInstanceVarName(iclsPtr->infoPtr->currIoPtr, ivPtr);
+	val = Tcl_GetVar2(interp, Tcl_GetString(objPtr), NULL, 0);
+	Tcl_DecrRefCount(objPtr);
     }
     return val;
 }
@@ -3548,13 +4787,10 @@ DelegationInstall(
     Tcl_HashEntry *hPtr2;
     Tcl_HashSearch search2;
     Tcl_Obj *componentValuePtr;
-    Tcl_DString buffer;
     ItclDelegatedFunction *idmPtr;
     ItclMemberFunc *imPtr;
-    ItclVariable *ivPtr;
     FOREACH_HASH_DECLS;
     char *methodName;
-    const char *val;
     int result;
     int noDelegate;
     int delegateAll;
@@ -3569,36 +4805,9 @@ DelegationInstall(
 	if (*methodName == '*') {
 	    delegateAll = 1;
 	}
-	if (idmPtr->icPtr != NULL) {
-	    Tcl_Obj *objPtr;
-	    /* we cannot use Itcl_GetInstanceVar here as the object is not
-	     * yet completely built. So use the varNsNamePtr
-	     */
-	    ivPtr = idmPtr->icPtr->ivPtr;
-	    if (ivPtr->flags & ITCL_COMMON) {
-		objPtr = Tcl_NewStringObj(ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-
-		Tcl_AppendToObj(objPtr, (Tcl_GetObjectNamespace(
-			ivPtr->iclsPtr->oPtr))->fullName, TCL_INDEX_NONE);
-		Tcl_AppendToObj(objPtr, "::", TCL_INDEX_NONE);
-		Tcl_AppendToObj(objPtr,
-			Tcl_GetString(idmPtr->icPtr->namePtr), TCL_INDEX_NONE);
-		val = Tcl_GetVar2(interp, Tcl_GetString(objPtr), NULL, 0);
-		Tcl_DecrRefCount(objPtr);
-	    } else {
-		Tcl_DStringInit(&buffer);
-		Tcl_DStringAppend(&buffer,
-			Tcl_GetString(ioPtr->varNsNamePtr), TCL_INDEX_NONE);
-		Tcl_DStringAppend(&buffer,
-			Tcl_GetString(ivPtr->fullNamePtr), TCL_INDEX_NONE);
-		val = Tcl_GetVar2(interp,
-			    Tcl_DStringValue(&buffer), NULL, 0);
-		Tcl_DStringFree(&buffer);
-	    }
-	    componentValuePtr = Tcl_NewStringObj(val, TCL_INDEX_NONE);
+	componentValuePtr = DelegationComponentValue(interp, ioPtr, idmPtr);
+	if (componentValuePtr != NULL) {
 	    Tcl_IncrRefCount(componentValuePtr);
-	} else {
-	    componentValuePtr = NULL;
 	}
 	if (!delegateAll) {
 	    result = DelegateFunction(interp, ioPtr, iclsPtr,
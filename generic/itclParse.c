@@ -1170,7 +1170,6 @@ ItclCheckForInitializedComponents(
 {
     FOREACH_HASH_DECLS;
     Tcl_CallFrame frame;
-    Tcl_DString buffer;
     ItclDelegatedFunction *idmPtr;
     int result;
     int doCheck;
@@ -1208,15 +1207,10 @@ ItclCheckForInitializedComponents(
 		    val = Tcl_GetVar2(interp, Tcl_GetString(objPtr), NULL, 0);
 		    Tcl_DecrRefCount(objPtr);
 		} else {
-		    Tcl_DStringInit(&buffer);
-		    Tcl_DStringAppend(&buffer,
-			    Tcl_GetString(ioPtr->varNsNamePtr), TCL_INDEX_NONE);
-		    Tcl_DStringAppend(&buffer,
-			    Tcl_GetString(idmPtr->icPtr->ivPtr->fullNamePtr),
-			    TCL_INDEX_NONE);
-		    val = Tcl_GetVar2(interp, Tcl_DStringValue(&buffer),
-			    NULL, 0);
-		    Tcl_DStringFree(&buffer);
+		    Tcl_Obj *objPtr;
+		    objPtr = ItclInstanceVarName(ioPtr, idmPtr->icPtr->ivPtr);
+		    val = Tcl_GetVar2(interp, Tcl_GetString(objPtr), NULL, 0);
+		    Tcl_DecrRefCount(objPtr);
 		}
 		if ((ioPtr != NULL) && ((val != NULL) && (strlen(val) == 0))) {
 		    val = ItclGetInstanceVar(
@@ -1394,6 +1388,8 @@ Itcl_ClassInheritCmd(
 	Itcl_AppendList(&iclsPtr->bases, baseClsPtr);
 	ItclPreserveClass(baseClsPtr);
     }
+    ItclResetMro(iclsPtr);
+    ItclResetObjectPlans(iclsPtr);
 
     /*
      *  Scan through the inheritance list to make sure that no
@@ -1539,6 +1535,8 @@ inheritError:
 	ItclReleaseClass( (ItclClass *)Itcl_GetListValue(elem) );
 	elem = Itcl_DeleteListElem(elem);
     }
+    ItclResetMro(iclsPtr);
+    ItclResetObjectPlans(iclsPtr);
     return TCL_ERROR;
 }
 
@@ -2402,7 +2400,7 @@ ItclDelObjectInfo(
 	    /*hPtr = Tcl_NextHashEntry(&place);*/
     }
     Tcl_DeleteHashTable(&infoPtr->objects);
-    Tcl_DeleteHashTable(&infoPtr->frameContext);
+    ItclFreeCallRecords(infoPtr);
 
     Itcl_DeleteStack(&infoPtr->clsStack);
     Itcl_Free(infoPtr);
@@ -2645,7 +2643,7 @@ ItclParseOption(
     }
     if (ioPtr != NULL) {
 	/* check for already delegated!! */
-	hPtr = Tcl_FindHashEntry(&ioPtr->objectDelegatedOptions,
+	hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(ioPtr)->objectDelegatedOptions,
 		(char *)objv[1]);
 	if (hPtr != NULL) {
 	    Tcl_AppendResult(interp, "cannot define option \"", optionName,
@@ -3393,7 +3391,7 @@ delegate method * ?to <componentName>? ?using <pattern>? ?except <methods>?";
     /* check for already delegated */
     methodNamePtr = Tcl_NewStringObj(methodName, TCL_INDEX_NONE);
     if (ioPtr != NULL) {
-	hPtr = Tcl_FindHashEntry(&ioPtr->objectDelegatedFunctions, (char *)
+	hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(ioPtr)->objectDelegatedFunctions, (char *)
 		methodNamePtr);
     } else {
 	hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions, (char *)
@@ -3687,7 +3685,7 @@ Itcl_HandleDelegateOptionCmd(
     allOptionNamePtr = Tcl_NewStringObj("*", TCL_INDEX_NONE);
     Tcl_IncrRefCount(allOptionNamePtr);
     if (ioPtr != NULL) {
-	hPtr = Tcl_FindHashEntry(&ioPtr->objectDelegatedOptions, (char *)
+	hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(ioPtr)->objectDelegatedOptions, (char *)
 		allOptionNamePtr);
     } else {
 	hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedOptions, (char *)
@@ -3738,7 +3736,7 @@ Itcl_HandleDelegateOptionCmd(
 	/* FIXME !!! */
 	/* check for valid option name */
 	if (ioPtr != NULL) {
-	    hPtr = Tcl_FindHashEntry(&ioPtr->objectOptions,
+	    hPtr = Tcl_FindHashEntry(&ITCL_OBJECT_EXT(ioPtr)->objectOptions,
 		    (char *)optionNamePtr);
 	} else {
 	    Itcl_InitHierIter(&hier, iclsPtr);
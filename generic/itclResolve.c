@@ -64,11 +64,11 @@ Itcl_ClassCmdResolver(
     Tcl_Command *rPtr)		/* returns: resolved command */
 {
     Tcl_HashEntry *hPtr;
-    Tcl_Obj *objPtr;
     Tcl_Obj *namePtr;
     ItclClass *iclsPtr;
     ItclObjectInfo *infoPtr;
     ItclMemberFunc *imPtr;
+    ItclCmdLookup *clookup;
     int inOptionHandling;
     int isCmdDeleted;
 
@@ -83,70 +83,43 @@ Itcl_ClassCmdResolver(
     }
     iclsPtr = (ItclClass *)Tcl_GetHashValue(hPtr);
     /*
-     *  If the command is a member function
+     *  If the command is a member function.  Probe the string keyed
+     *  view of the resolution table, so that no Tcl_Obj has to be
+     *  created just for the lookup.
      */
-    imPtr = NULL;
-    objPtr = Tcl_NewStringObj(name, TCL_INDEX_NONE);
-    hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmds, (char *)objPtr);
-    Tcl_DecrRefCount(objPtr);
+    hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmdNames, name);
     if (hPtr == NULL) {
-	ItclCmdLookup *clookup;
-	if ((iclsPtr->flags & ITCL_ECLASS)) {
-	    namePtr = Tcl_NewStringObj(name, TCL_INDEX_NONE);
-	    hPtr = Tcl_FindHashEntry(&iclsPtr->delegatedFunctions,
-		    (char *)namePtr);
+	if ((iclsPtr->flags & ITCL_ECLASS)
+		&& (iclsPtr->delegatedFunctions.numEntries > 0)) {
+	    /*
+	     *  A delegated function is handled by the "unknown" method.
+	     *  Check for that one first, it is the cheaper probe.
+	     */
+	    hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmdNames, "unknown");
 	    if (hPtr != NULL) {
-		objPtr = Tcl_NewStringObj("unknown", TCL_INDEX_NONE);
-		hPtr = Tcl_FindHashEntry(&iclsPtr->resolveCmds, (char *)objPtr);
-		Tcl_DecrRefCount(objPtr);
+		namePtr = Tcl_NewStringObj(name, TCL_INDEX_NONE);
+		if (Tcl_FindHashEntry(&iclsPtr->delegatedFunctions,
+			(char *)namePtr) == NULL) {
+		    hPtr = NULL;
+		}
+		Tcl_DecrRefCount(namePtr);
 	    }
-	    Tcl_DecrRefCount(namePtr);
 	}
 	if (hPtr == NULL) {
 	    return TCL_CONTINUE;
 	}
-	clookup = (ItclCmdLookup *)Tcl_GetHashValue(hPtr);
-	imPtr = clookup->imPtr;
-    } else {
-	ItclCmdLookup *clookup;
-	clookup = (ItclCmdLookup *)Tcl_GetHashValue(hPtr);
-	imPtr = clookup->imPtr;
     }
+    clookup = (ItclCmdLookup *)Tcl_GetHashValue(hPtr);
+    imPtr = clookup->imPtr;
 
     if (iclsPtr->flags & (ITCL_TYPE|ITCL_WIDGET|ITCL_WIDGETADAPTOR)) {
 	/* FIXME check if called from an (instance) method (not from a typemethod) and only then error */
-	int isOk = 0;
-	if (strcmp(name, "info") == 0) {
-	    isOk = 1;
-	}
-	if (strcmp(name, "mytypemethod") == 0) {
-	    isOk = 1;
-	}
-	if (strcmp(name, "myproc") == 0) {
-	    isOk = 1;
-	}
-	if (strcmp(name, "mymethod") == 0) {
-	    isOk = 1;
-	}
-	if (strcmp(name, "mytypevar") == 0) {
-	    isOk = 1;
-	}
-	if (strcmp(name, "myvar") == 0) {
-	    isOk = 1;
-	}
-	if (strcmp(name, "itcl_hull") == 0) {
-	    isOk = 1;
-	}
-	if (strcmp(name, "callinstance") == 0) {
-	    isOk = 1;
-	}
-	if (strcmp(name, "getinstancevar") == 0) {
-	    isOk = 1;
-	}
-	if (strcmp(name, "installcomponent") == 0) {
-	    isOk = 1;
-	}
-	if (! isOk) {
+	/*
+	 *  Only the plain member name gets through from any context,
+	 *  qualified spellings like "dog::myvar" are checked below.
+	 */
+	if (!(imPtr->flags & ITCL_ANY_CONTEXT)
+		|| (strcmp(name, Tcl_GetString(imPtr->namePtr)) != 0)) {
 	    if ((imPtr->flags & ITCL_TYPE_METHOD) != 0) {
 		Tcl_AppendResult(interp, "invalid command name \"", name,
 			 "\"", (char *)NULL);
@@ -246,6 +219,7 @@ Itcl_ClassVarResolver(
     ItclObject *contextIoPtr;
     Tcl_HashEntry *hPtr;
     ItclVarLookup *vlookup;
+    Tcl_Var varPtr;
 
     contextIoPtr = NULL;
     /*
@@ -312,82 +286,38 @@ Itcl_ClassVarResolver(
     if (hPtr == NULL) {
 	return TCL_CONTINUE;
     }
+    if (vlookup->specialKind == ITCL_VAR_KIND_THIS) {
+	/* "this" always refers to the most specific class scope */
+	if (contextIoPtr->thisVarPtr != NULL) {
+	    *rPtr = contextIoPtr->thisVarPtr;
+	    return TCL_OK;
+	}
 	if (contextIoPtr->iclsPtr != vlookup->ivPtr->iclsPtr) {
-	    if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr), "this") == 0) {
-		hPtr = ItclResolveVarEntry(contextIoPtr->iclsPtr,
-		    Tcl_GetString(vlookup->ivPtr->namePtr));
-
-		if (hPtr != NULL) {
-		    vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
-		}
+	    hPtr = ItclResolveVarEntry(contextIoPtr->iclsPtr, "this");
+	    if (hPtr != NULL) {
+		vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
 	    }
 	}
+    }
+    varPtr = ItclGetObjectVarSlot(contextIoPtr, vlookup);
+    if (varPtr == NULL) {
 	hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables,
 		(char *)vlookup->ivPtr);
-
-    if (hPtr == NULL) {
-	return TCL_CONTINUE;
-    }
-    if (strcmp(name, "this") == 0) {
-	Tcl_Var varPtr;
-	Tcl_DString buffer;
-
-	Tcl_DStringInit(&buffer);
-	Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer,
-		(Tcl_GetObjectNamespace(contextIoPtr->oPtr)->fullName), TCL_INDEX_NONE);
-	if (vlookup->ivPtr->iclsPtr->nsPtr == NULL) {
-	    /* deletion of class is running */
-	    Tcl_DStringAppend(&buffer,
-		     Tcl_GetCurrentNamespace(interp)->fullName, TCL_INDEX_NONE);
-	} else {
-	    Tcl_DStringAppend(&buffer,
-		     vlookup->ivPtr->iclsPtr->nsPtr->fullName, TCL_INDEX_NONE);
-	}
-	Tcl_DStringAppend(&buffer, "::this", 6);
-	varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer), NULL, 0);
-	if (varPtr != NULL) {
-	    *rPtr = varPtr;
-	    return TCL_OK;
-	}
-    }
-    if (strcmp(name, "itcl_options") == 0) {
-	Tcl_Var varPtr;
-	Tcl_DString buffer;
-
-	Tcl_DStringInit(&buffer);
-	Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer,
-		(Tcl_GetObjectNamespace(contextIoPtr->oPtr)->fullName), TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer, "::itcl_options", TCL_INDEX_NONE);
-	varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer), NULL, 0);
-	Tcl_DStringFree(&buffer);
-	if (varPtr != NULL) {
-	    *rPtr = varPtr;
-	    return TCL_OK;
+	if (hPtr == NULL) {
+	    return TCL_CONTINUE;
 	}
+	varPtr = (Tcl_Var)Tcl_GetHashValue(hPtr);
     }
-    if (strcmp(name, "itcl_option_components") == 0) {
-	Tcl_Var varPtr;
-	Tcl_DString buffer;
-
-	Tcl_DStringInit(&buffer);
-	Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer,
-		(Tcl_GetObjectNamespace(contextIoPtr->oPtr)->fullName), TCL_INDEX_NONE);
-	Tcl_DStringAppend(&buffer, "::itcl_option_components", TCL_INDEX_NONE);
-	varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer), NULL, 0);
-	Tcl_DStringFree(&buffer);
-	if (varPtr != NULL) {
-	    *rPtr = varPtr;
-	    return TCL_OK;
+    if (vlookup->specialKind != ITCL_VAR_KIND_NORMAL) {
+	Tcl_Var specialVarPtr = ItclObjectSpecialVar(interp, contextIoPtr,
+		vlookup->specialKind);
+
+	if (specialVarPtr != NULL) {
+	    varPtr = specialVarPtr;
 	}
     }
-    if (hPtr != NULL) {
-	*rPtr = (Tcl_Var)Tcl_GetHashValue(hPtr);
-	return TCL_OK;
-    }
-    return TCL_CONTINUE;
+    *rPtr = varPtr;
+    return TCL_OK;
 }
 
 
@@ -499,6 +429,7 @@ ItclClassRuntimeVarResolver(
     ItclClass *iclsPtr;
     ItclObject *contextIoPtr;
     Tcl_HashEntry *hPtr;
+    Tcl_Var varPtr;
 
     /*
      *  If this is a common data member, then the associated
@@ -524,82 +455,89 @@ ItclClassRuntimeVarResolver(
 	return NULL;
     }
 
-	if (contextIoPtr->iclsPtr != vlookup->ivPtr->iclsPtr) {
-	    if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr), "this") == 0) {
-		/* only for the this variable we need the one of the
-		 * contextIoPtr class */
-		hPtr = ItclResolveVarEntry(contextIoPtr->iclsPtr,
-			Tcl_GetString(vlookup->ivPtr->namePtr));
-
-		if (hPtr != NULL) {
-		    vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
-		}
-	    }
-	}
-	hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables,
-		(char *)vlookup->ivPtr);
-	if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr), "this") == 0) {
-	    Tcl_Var varPtr;
-	    Tcl_DString buffer;
-
-	    Tcl_DStringInit(&buffer);
-	    Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-	    Tcl_DStringAppend(&buffer,
-		    (Tcl_GetObjectNamespace(contextIoPtr->oPtr)->fullName), TCL_INDEX_NONE);
-	    if (vlookup->ivPtr->iclsPtr->nsPtr == NULL) {
-		Tcl_DStringAppend(&buffer,
-			Tcl_GetCurrentNamespace(interp)->fullName, TCL_INDEX_NONE);
-	    } else {
-		Tcl_DStringAppend(&buffer,
-			vlookup->ivPtr->iclsPtr->nsPtr->fullName, TCL_INDEX_NONE);
-	    }
-	    Tcl_DStringAppend(&buffer, "::this", 6);
-	    varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer),
-		    NULL, 0);
-	    if (varPtr != NULL) {
-		return varPtr;
-	    }
-	}
-	if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr),
-		"itcl_options") == 0) {
-	    Tcl_Var varPtr;
-	    Tcl_DString buffer;
-
-	    Tcl_DStringInit(&buffer);
-	    Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-	    Tcl_DStringAppend(&buffer,
-		    (Tcl_GetObjectNamespace(contextIoPtr->oPtr)->fullName), TCL_INDEX_NONE);
-	    Tcl_DStringAppend(&buffer, "::itcl_options", TCL_INDEX_NONE);
-	    varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer),
-		    NULL, 0);
-	    Tcl_DStringFree(&buffer);
-	    if (varPtr != NULL) {
-		return varPtr;
-	    }
+    if (vlookup->specialKind != ITCL_VAR_KIND_NORMAL) {
+	varPtr = ItclObjectSpecialVar(interp, contextIoPtr,
+		vlookup->specialKind);
+	if (varPtr != NULL) {
+	    return varPtr;
 	}
-	if (strcmp(Tcl_GetString(vlookup->ivPtr->namePtr),
-		"itcl_option_components") == 0) {
-	    Tcl_Var varPtr;
-	    Tcl_DString buffer;
-
-	    Tcl_DStringInit(&buffer);
-	    Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
-	    Tcl_DStringAppend(&buffer,
-		    (Tcl_GetObjectNamespace(contextIoPtr->oPtr)->fullName), TCL_INDEX_NONE);
-	    Tcl_DStringAppend(&buffer, "::itcl_option_components", TCL_INDEX_NONE);
-	    varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer),
-		    NULL, 0);
-	    Tcl_DStringFree(&buffer);
-	    if (varPtr != NULL) {
-		return varPtr;
+	if ((vlookup->specialKind == ITCL_VAR_KIND_THIS)
+		&& (contextIoPtr->iclsPtr != vlookup->ivPtr->iclsPtr)) {
+	    /* only for the this variable we need the one of the
+	     * contextIoPtr class */
+	    hPtr = ItclResolveVarEntry(contextIoPtr->iclsPtr, "this");
+	    if (hPtr != NULL) {
+		vlookup = (ItclVarLookup*)Tcl_GetHashValue(hPtr);
 	    }
 	}
-	if (hPtr != NULL) {
-	    return (Tcl_Var)Tcl_GetHashValue(hPtr);
-	}
+    }
+    varPtr = ItclGetObjectVarSlot(contextIoPtr, vlookup);
+    if (varPtr != NULL) {
+	return varPtr;
+    }
+    hPtr = Tcl_FindHashEntry(&contextIoPtr->objectVariables,
+	    (char *)vlookup->ivPtr);
+    if (hPtr != NULL) {
+	return (Tcl_Var)Tcl_GetHashValue(hPtr);
+    }
     return NULL;
 }
 
+/*
+ * ------------------------------------------------------------------------
+ *  ItclObjectSpecialVar()
+ *
+ *  Returns the variable for one of the built-in "this", "itcl_options"
+ *  or "itcl_option_components" variables of an object.  The handle for
+ *  "this" is recorded when the object variables are created.  The
+ *  option variables live in the object variables namespace and are
+ *  created on demand, so they are looked up once and kept preserved
+ *  in the object until it is freed.  Returns NULL if the variable
+ *  does not exist (yet).
+ * ------------------------------------------------------------------------
+ */
+Tcl_Var
+ItclObjectSpecialVar(
+    Tcl_Interp *interp,	       /* current interpreter */
+    ItclObject *ioPtr,	       /* object context */
+    int specialKind)	       /* ITCL_VAR_KIND_* of the variable */
+{
+    Tcl_Var *cachePtr;
+    Tcl_Var varPtr;
+    Tcl_DString buffer;
+    const char *tail;
+
+    switch (specialKind) {
+    case ITCL_VAR_KIND_THIS:
+	return ioPtr->thisVarPtr;
+    case ITCL_VAR_KIND_OPTIONS:
+	cachePtr = &ioPtr->optionsVarPtr;
+	tail = "::itcl_options";
+	break;
+    case ITCL_VAR_KIND_OPTION_COMPONENTS:
+	cachePtr = &ioPtr->optionComponentsVarPtr;
+	tail = "::itcl_option_components";
+	break;
+    default:
+	return NULL;
+    }
+    if (*cachePtr != NULL) {
+	return *cachePtr;
+    }
+    Tcl_DStringInit(&buffer);
+    Tcl_DStringAppend(&buffer, ITCL_VARIABLES_NAMESPACE, TCL_INDEX_NONE);
+    Tcl_DStringAppend(&buffer,
+	    (Tcl_GetObjectNamespace(ioPtr->oPtr)->fullName), TCL_INDEX_NONE);
+    Tcl_DStringAppend(&buffer, tail, TCL_INDEX_NONE);
+    varPtr = Itcl_FindNamespaceVar(interp, Tcl_DStringValue(&buffer), NULL, 0);
+    Tcl_DStringFree(&buffer);
+    if (varPtr != NULL) {
+	Itcl_PreserveVar(varPtr);
+	*cachePtr = varPtr;
+    }
+    return varPtr;
+}
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_ParseVarResolver()
@@ -854,6 +854,10 @@ Itcl_ParseNamespPath(
  *  can be accessed only if the "from" namespace is the same as the
  *  class that contains them.
  *
+ *  The access granted to the last namespace checked is remembered in
+ *  the class until infoPtr->accessEpoch changes, so repeated checks
+ *  from the same namespace only compare two words.
+ *
  *  Returns 1/0 indicating true/false.
  * ------------------------------------------------------------------------
  */
@@ -863,51 +867,48 @@ Itcl_CanAccess2(
     int protection,            /* protection level being tested */
     Tcl_Namespace* fromNsPtr)  /* namespace requesting access */
 {
+    ItclObjectInfo *infoPtr;
     ItclClass* fromIclsPtr;
     Tcl_HashEntry *entry;
 
     /*
-     *  If the protection level is "public" or "private", then the
-     *  answer is known immediately.
+     *  If the protection level is "public", then the answer is
+     *  known immediately.
      */
     if (protection == ITCL_PUBLIC) {
 	return 1;
-    } else {
-	if (protection == ITCL_PRIVATE) {
-	    entry = Tcl_FindHashEntry(&iclsPtr->infoPtr->namespaceClasses,
-		fromNsPtr);
-	    if (entry == NULL) {
-		return 0;
-	    }
-	    return (iclsPtr == Tcl_GetHashValue(entry));
-	}
     }
+    assert (protection == ITCL_PROTECTED || protection == ITCL_PRIVATE);
 
-    /*
-     *  If the protection level is "protected", then check the
-     *  heritage of the namespace requesting access.  If cdefnPtr
-     *  is in the heritage, then access is allowed.
-     */
-    assert (protection == ITCL_PROTECTED);
-
-    if (Itcl_IsClassNamespace(fromNsPtr)) {
-	entry = Tcl_FindHashEntry(&iclsPtr->infoPtr->namespaceClasses,
-		fromNsPtr);
-	if (entry == NULL) {
-	    return 0;
-	}
-	fromIclsPtr = (ItclClass *)Tcl_GetHashValue(entry);
-
-	entry = Tcl_FindHashEntry(&fromIclsPtr->heritage,
-		(char*)iclsPtr);
-
-	if (entry) {
-	    return 1;
+    infoPtr = iclsPtr->infoPtr;
+    if ((iclsPtr->accessNsPtr != fromNsPtr)
+	    || (iclsPtr->accessEpoch != infoPtr->accessEpoch)) {
+	/*
+	 *  Private things are accessible from the class itself.  For
+	 *  protected things, check the heritage of the namespace
+	 *  requesting access.  If iclsPtr is in the heritage, then
+	 *  access is allowed.
+	 */
+	iclsPtr->accessFlags = 0;
+	entry = Tcl_FindHashEntry(&infoPtr->namespaceClasses, fromNsPtr);
+	if (entry != NULL) {
+	    fromIclsPtr = (ItclClass *)Tcl_GetHashValue(entry);
+	    if (fromIclsPtr == iclsPtr) {
+		iclsPtr->accessFlags =
+			ITCL_ACCESS_PRIVATE|ITCL_ACCESS_PROTECTED;
+	    } else if (ItclClassIsa(fromIclsPtr, iclsPtr)) {
+		iclsPtr->accessFlags = ITCL_ACCESS_PROTECTED;
+	    }
 	}
+	iclsPtr->accessNsPtr = fromNsPtr;
+	iclsPtr->accessEpoch = infoPtr->accessEpoch;
     }
-    return 0;
+    if (protection == ITCL_PRIVATE) {
+	return (iclsPtr->accessFlags & ITCL_ACCESS_PRIVATE) != 0;
+    }
+    return (iclsPtr->accessFlags & ITCL_ACCESS_PROTECTED) != 0;
 }
-
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_CanAccess()
@@ -933,20 +934,16 @@ Itcl_CanAccess(
 
 /*
  * ------------------------------------------------------------------------
- *  Itcl_CanAccessFunc()
+ *  CanAccessOverridden()
  *
- *  Checks to see if a member function with the specified protection
- *  level can be accessed from a particular namespace context.  This
- *  follows the same rules enforced by Itcl_CanAccess, but adds one
- *  special case:  If the function is a protected method, and if the
- *  current context is a base class that has the same method, then
- *  access is allowed.
+ *  Helper for Itcl_CanAccessFunc.  Checks whether the namespace is
+ *  a base class with a method that the member function overrides.
  *
  *  Returns 1/0 indicating true/false.
  * ------------------------------------------------------------------------
  */
-int
-Itcl_CanAccessFunc(
+static int
+CanAccessOverridden(
     ItclMemberFunc* imPtr,     /* member function being tested */
     Tcl_Namespace* fromNsPtr)  /* namespace requesting access */
 {
@@ -955,13 +952,6 @@ Itcl_CanAccessFunc(
     ItclMemberFunc *ovlfunc;
     Tcl_HashEntry *entry;
 
-    /*
-     *  Apply the usual rules first.
-     */
-    if (Itcl_CanAccess(imPtr, fromNsPtr)) {
-	return 1;
-    }
-
     /*
      *  As a last resort, see if the namespace is really a base
      *  class of the class containing the method.  Look for a
@@ -981,7 +971,7 @@ Itcl_CanAccessFunc(
 	}
 	fromIclsPtr = (ItclClass *)Tcl_GetHashValue(hPtr);
 
-	if (Tcl_FindHashEntry(&iclsPtr->heritage, (char*)fromIclsPtr)) {
+	if (ItclClassIsa(iclsPtr, fromIclsPtr)) {
 	    entry = Tcl_FindHashEntry(&fromIclsPtr->resolveCmds,
 		(char *)imPtr->namePtr);
 
@@ -999,7 +989,49 @@ Itcl_CanAccessFunc(
     return 0;
 }
 
-
+/*
+ * ------------------------------------------------------------------------
+ *  Itcl_CanAccessFunc()
+ *
+ *  Checks to see if a member function with the specified protection
+ *  level can be accessed from a particular namespace context.  This
+ *  follows the same rules enforced by Itcl_CanAccess, but adds one
+ *  special case:  If the function is a protected method, and if the
+ *  current context is a base class that has the same method, then
+ *  access is allowed.
+ *
+ *  Returns 1/0 indicating true/false.
+ * ------------------------------------------------------------------------
+ */
+int
+Itcl_CanAccessFunc(
+    ItclMemberFunc* imPtr,     /* member function being tested */
+    Tcl_Namespace* fromNsPtr)  /* namespace requesting access */
+{
+    ItclClass *iclsPtr;
+
+    /*
+     *  Apply the usual rules first.
+     */
+    if (Itcl_CanAccess(imPtr, fromNsPtr)) {
+	return 1;
+    }
+
+    /*
+     *  The answer of the last resort below depends on the virtual
+     *  tables, so remember it like Itcl_CanAccess2() does.
+     */
+    iclsPtr = imPtr->iclsPtr;
+    if ((imPtr->accessNsPtr != fromNsPtr)
+	    || (imPtr->accessEpoch != iclsPtr->infoPtr->accessEpoch)) {
+	imPtr->accessOk = CanAccessOverridden(imPtr, fromNsPtr);
+	imPtr->accessNsPtr = fromNsPtr;
+	imPtr->accessEpoch = iclsPtr->infoPtr->accessEpoch;
+    }
+    return imPtr->accessOk;
+}
+
+
 /*
  * ------------------------------------------------------------------------
  *  Itcl_DecodeScopedCommand()
@@ -156,6 +156,144 @@ proc test-access {{reptime 1000}} {
 
 # ------------------------------------------------------------------------
 
+# instance variables in methods (slot array vs. objectVariables hash):
+proc test-var-slots {{reptime 1000}} {
+  _test_start $reptime
+  itcl::class ::timeSlotBase {
+    public variable a 0
+    protected variable b 1
+    private variable c 2
+    for {set j 0} {$j<100} {incr j} { public variable d$j $j }
+    public method geta {} {set a}
+    public method getb {} {set b}
+    public method getc {} {set c}
+    public method getall {} {list $a $b $c $d0 $d50 $d99}
+  }
+  itcl::class ::timeSlotDerived1 { inherit ::timeSlotBase; public variable e1 0 }
+  itcl::class ::timeSlotDerived2 { inherit ::timeSlotBase; public variable e2 0 }
+  itcl::class ::timeSlotOther { public variable x 0 }
+  itcl::class ::timeSlotMI1 { inherit ::timeSlotOther ::timeSlotBase }
+  itcl::class ::timeSlotMI2 { inherit ::timeSlotOther ::timeSlotBase; public variable y 0 }
+  _test_run $reptime {
+    setup {
+      ::timeSlotBase ob; ::timeSlotDerived1 o1; ::timeSlotDerived2 o2
+      ::timeSlotMI1 m1; ::timeSlotMI2 m2
+    }
+    # same class (slot kept in lookup record)
+    {ob geta}
+    {ob getb}
+    {ob getc}
+    {ob getall}
+    # derived class, base method (same slot as in the base class)
+    {o1 geta}
+    {o1 getall}
+    # alternating derived classes (same slot as in the base class)
+    {o1 geta; o2 geta}
+    {o1 getall; o2 getall}
+    # alternating classes reaching the base through a second base class
+    # (slot looked up in class table)
+    {m1 getall; m2 getall}
+    cleanup {itcl::delete object ob o1 o2 m1 m2}
+  }
+  itcl::delete class ::timeSlotBase ::timeSlotOther
+  _test_out_total
+}
+
+# ------------------------------------------------------------------------
+
+# options of types (itcl_options elements cached in the object):
+proc test-type-options {{reptime 1000}} {
+  _test_start $reptime
+  set body {method getopt {} {set itcl_options(-o15)}}
+  for {set j 0} {$j<30} {incr j} { append body "\noption -o$j v$j" }
+  itcl::type ::timeOptType $body
+  _test_run $reptime {
+    setup {::timeOptType ot}
+    {ot cget -o15}
+    {ot configure -o15 x}
+    {ot configure -o1 a -o15 b -o29 c}
+    {ot getopt}
+    cleanup {ot destroy}
+    # create + delete object with 30 options:
+    {::timeOptType ot; ot destroy}
+  }
+  ::timeOptType destroy
+  _test_out_total
+}
+
+# ------------------------------------------------------------------------
+
+# configure of public variables:
+proc test-public-config {{reptime 1000}} {
+  _test_start $reptime
+  set body {}
+  for {set j 0} {$j<20} {incr j} { append body "\npublic variable p$j v$j" }
+  append body "\npublic variable c 0 {incr cnt}\nprotected variable cnt 0"
+  itcl::class ::timePubCfg $body
+  _test_run $reptime {
+    setup {::timePubCfg pc}
+    {pc configure}
+    {pc configure -p1 a -p10 b -p19 c}
+    {pc configure -p5 x; pc configure}
+    {pc configure -c 1 -p3 y -c 2}
+    cleanup {itcl::delete object pc}
+  }
+  itcl::delete class ::timePubCfg
+  _test_out_total
+}
+
+# ------------------------------------------------------------------------
+
+# delegated methods (each object with an own component):
+proc test-delegate-method {{reptime 1000}} {
+  _test_start $reptime
+  itcl::class ::timeDlgTarget {method wag {args} {return $args}}
+  itcl::extendedclass ::timeDlgOwner {
+    component tail
+    delegate method wag to tail
+    delegate method bark to tail as {wag woof}
+    constructor {} {set tail [namespace which [::timeDlgTarget #auto]]}
+    method retail {} {set tail [namespace which [::timeDlgTarget #auto]]}
+  }
+  _test_run $reptime {
+    setup {::timeDlgOwner d1; ::timeDlgOwner d2}
+    {d1 wag}
+    {d2 wag 1 2}
+    {d1 bark}
+    {d1 retail; d1 wag}
+    cleanup {itcl::delete object d1 d2}
+  }
+  itcl::delete class ::timeDlgOwner ::timeDlgTarget
+  _test_out_total
+}
+
+# rebind the component of a class with 50 delegated methods 1M times:
+proc test-component-swap {{reptime {60000 1}}} {
+  _test_start $reptime
+  itcl::class ::timeSwapBackend {method get {args} {return $args}}
+  set body {
+    component backend
+    constructor {} {set backend ::timeSwap0}
+    method rebind {b} {set backend $b}
+  }
+  for {set j 0} {$j<50} {incr j} { append body "\ndelegate method m$j to backend as get" }
+  itcl::extendedclass ::timeSwapPool $body
+  ::timeSwapBackend ::timeSwap0; ::timeSwapBackend ::timeSwap1
+  ::timeSwapPool ::timeSwapP
+  _test_run -no-result $reptime {
+    # 1M swaps:
+    {for {set i 0} {$i < 1000000} {incr i} {::timeSwapP rebind ::timeSwap[expr {$i & 1}]}}
+    # 1M rebinds to the same backend:
+    {for {set i 0} {$i < 1000000} {incr i} {::timeSwapP rebind ::timeSwap0}}
+    # 1M swaps, each followed by a delegated call:
+    {for {set i 0} {$i < 1000000} {incr i} {::timeSwapP rebind ::timeSwap[expr {$i & 1}]; ::timeSwapP m7}}
+  }
+  itcl::delete class ::timeSwapPool ::timeSwapBackend
+  _test_out_total
+}
+
+# ------------------------------------------------------------------------
+
 # create/delete object:
 proc test-obj-instance {{reptime 1000}} {
   _test_start $reptime
@@ -178,6 +316,73 @@ proc test-obj-instance {{reptime 1000}} {
   _test_out_total
 }
 
+# delete class with many instances among many other objects:
+proc test-cls-delete {{reptime {60000 1}}} {
+  _test_start $reptime
+  itcl::class ::timeBulkClass {}
+  itcl::class ::timeDelClass {}
+  for {set i 0} {$i < 1000000} {incr i} { ::timeBulkClass bulk$i }
+  for {set i 0} {$i < 100000} {incr i} { ::timeDelClass del$i }
+  _test_run -no-result $reptime {
+    # delete class with 100K instances while 1M other objects exist:
+    {itcl::delete class ::timeDelClass}
+    # find/info instances of a class with few instances:
+    setup {itcl::class ::timeDelClass {}; ::timeDelClass ::del0; ::timeDelClass ::del1}
+    {itcl::find objects -class ::timeDelClass}
+    {itcl::find objects -isa ::timeDelClass}
+    {itcl::find objects del1}
+    {::del0 info instances}
+    cleanup {itcl::delete class ::timeDelClass}
+  }
+  itcl::delete class ::timeBulkClass
+  _test_out_total
+}
+
+# ------------------------------------------------------------------------
+
+# ensembles with many parts (build from a body, dispatch):
+proc test-ensemble {{reptime {60000 1}}} {
+  _test_start $reptime
+  set body {}
+  for {set j 4000} {$j > 0} {incr j -1} { append body "\npart p$j {} {return $j}" }
+  _test_run -no-result $reptime [string map [list \$body [list $body]] {
+    # build an ensemble with 4000 parts:
+    {itcl::ensemble ::timeEns $body}
+    # 100K calls of a part by full name and by abbreviation:
+    {for {set i 0} {$i < 100000} {incr i} {::timeEns p1234}}
+    {for {set i 0} {$i < 100000} {incr i} {::timeEns p399}}
+    cleanup {itcl::delete ensemble ::timeEns}
+  }]
+  _test_out_total
+}
+
+# ------------------------------------------------------------------------
+
+# protected and overridden methods called from a derived/base class:
+proc test-protected-call {{reptime 1000}} {
+  _test_start $reptime
+  itcl::class ::timeProtBase {
+    protected method helper {} {}
+    protected method hook {} {}
+    method callhook {} {hook}
+  }
+  itcl::class ::timeProtDerived {
+    inherit ::timeProtBase
+    protected method hook {} {}
+    method callhelper {} {helper}
+  }
+  _test_run $reptime {
+    setup {::timeProtDerived o}
+    # protected base method called from derived class:
+    {o callhelper}
+    # protected method overridden in derived class called from base:
+    {o callhook}
+    cleanup {itcl::delete object o}
+  }
+  itcl::delete class ::timeProtBase
+  _test_out_total
+}
+
 # ------------------------------------------------------------------------
 
 proc test {{reptime 1000}} {
@@ -192,8 +397,23 @@ proc test {{reptime 1000}} {
   test-var-create $reptm
   puts "==== var access ====\n"
   test-access $reptime
+  puts "==== var slots ====\n"
+  test-var-slots $reptime
+  puts "==== type options ====\n"
+  test-type-options $reptime
+  puts "==== public variable options ====\n"
+  test-public-config $reptime
+  puts "==== delegated methods ====\n"
+  test-delegate-method $reptime
+  test-component-swap
   puts "==== object instance ====\n"
   test-obj-instance $reptime
+  puts "==== class deletion ====\n"
+  test-cls-delete
+  puts "==== ensembles ====\n"
+  test-ensemble
+  puts "==== protected methods ====\n"
+  test-protected-call $reptime
 
   puts \n**OK**
 }